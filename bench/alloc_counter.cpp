@@ -0,0 +1,108 @@
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "harness.h"
+
+// 替换全局 operator new / delete 以统计分配次数和字节数。
+// glibc 下用 malloc_usable_size 跟踪存活字节数及其峰值，其他平台峰值恒为 0。
+namespace {
+
+std::atomic<std::uint64_t> allocCount{0};
+std::atomic<std::uint64_t> allocBytes{0};
+std::atomic<std::uint64_t> live{0};
+std::atomic<std::uint64_t> peak{0};
+
+void noteAllocation(void *p, std::size_t size) {
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    allocBytes.fetch_add(size, std::memory_order_relaxed);
+#if defined(__GLIBC__)
+    const std::uint64_t usable = malloc_usable_size(p);
+    const std::uint64_t now = live.fetch_add(usable, std::memory_order_relaxed) + usable;
+    std::uint64_t seen = peak.load(std::memory_order_relaxed);
+    while (now > seen && !peak.compare_exchange_weak(seen, now, std::memory_order_relaxed)) {
+    }
+#else
+    (void)p;
+#endif
+}
+
+void noteRelease(void *p) {
+#if defined(__GLIBC__)
+    if (p) live.fetch_sub(malloc_usable_size(p), std::memory_order_relaxed);
+#else
+    (void)p;
+#endif
+}
+
+void *allocate(std::size_t size) {
+    void *p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    noteAllocation(p, size);
+    return p;
+}
+
+void *allocateAligned(std::size_t size, std::align_val_t align) {
+    const std::size_t alignment = static_cast<std::size_t>(align);
+    const std::size_t rounded = (size + alignment - 1) / alignment * alignment;
+    void *p = std::aligned_alloc(alignment, rounded ? rounded : alignment);
+    if (!p) throw std::bad_alloc();
+    noteAllocation(p, size);
+    return p;
+}
+
+void release(void *p) noexcept {
+    noteRelease(p);
+    std::free(p);
+}
+
+}  // namespace
+
+namespace bench {
+
+AllocStats allocSnapshot() {
+    return {allocCount.load(std::memory_order_relaxed), allocBytes.load(std::memory_order_relaxed)};
+}
+
+std::uint64_t liveBytes() { return live.load(std::memory_order_relaxed); }
+std::uint64_t peakLiveBytes() { return peak.load(std::memory_order_relaxed); }
+void resetPeakLiveBytes() { peak.store(live.load(std::memory_order_relaxed), std::memory_order_relaxed); }
+
+}  // namespace bench
+
+void *operator new(std::size_t size) { return allocate(size); }
+void *operator new[](std::size_t size) { return allocate(size); }
+void *operator new(std::size_t size, std::align_val_t align) { return allocateAligned(size, align); }
+void *operator new[](std::size_t size, std::align_val_t align) { return allocateAligned(size, align); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    try {
+        return allocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    try {
+        return allocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void *p) noexcept { release(p); }
+void operator delete[](void *p) noexcept { release(p); }
+void operator delete(void *p, std::size_t) noexcept { release(p); }
+void operator delete[](void *p, std::size_t) noexcept { release(p); }
+void operator delete(void *p, std::align_val_t) noexcept { release(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { release(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { release(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { release(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { release(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { release(p); }
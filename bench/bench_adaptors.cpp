@@ -0,0 +1,61 @@
+#include <queue>
+#include <stack>
+
+#include "harness.h"
+#include "queue.cpp"
+#include "stack.cpp"
+#include "workloads.h"
+
+namespace bench {
+namespace {
+
+template <typename T, typename Stack>
+void runStack(Runner &runner, const char *impl, std::size_t n) {
+    using E = Element<T>;
+    runner.measure({"stack", "push+pop", impl, E::name, n, 2 * n},
+                   [] { return Stack(); },
+                   [&](Stack &s) {
+                       for (std::size_t i = 0; i < n; ++i) s.push(E::make(i));
+                       std::uint64_t sum = 0;
+                       while (!s.empty()) {
+                           sum += E::key(s.top());
+                           s.pop();
+                       }
+                       doNotOptimize(sum);
+                   });
+}
+
+template <typename T, typename Queue>
+void runQueue(Runner &runner, const char *impl, std::size_t n) {
+    using E = Element<T>;
+    runner.measure({"queue", "push+pop", impl, E::name, n, 2 * n},
+                   [] { return Queue(); },
+                   [&](Queue &q) {
+                       for (std::size_t i = 0; i < n; ++i) q.push(E::make(i));
+                       std::uint64_t sum = 0;
+                       while (!q.empty()) {
+                           sum += E::key(q.front());
+                           q.pop();
+                       }
+                       doNotOptimize(sum);
+                   });
+}
+
+template <typename T>
+void runElement(Runner &runner, std::size_t n) {
+    runStack<T, MyStack<T>>(runner, "MyStack", n);
+    runStack<T, std::stack<T>>(runner, "std::stack", n);
+    runQueue<T, MyQueue<T>>(runner, "MyQueue", n);
+    runQueue<T, std::queue<T>>(runner, "std::queue", n);
+}
+
+}  // namespace
+
+void adaptorSuite(Runner &runner) {
+    for (std::size_t n : runner.config().sizes) {
+        runElement<std::uint64_t>(runner, n);
+        if (n <= runner.config().largeElementLimit) runElement<Large>(runner, n);
+    }
+}
+
+}  // namespace bench
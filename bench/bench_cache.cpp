@@ -0,0 +1,71 @@
+#include <thread>
+#include <vector>
+
+#include "cache.cpp"
+#include "harness.h"
+#include "workloads.h"
+
+namespace bench {
+namespace {
+
+// 单线程：容量为键空间的 1/10，Zipfian 访问，未命中时回填；附带命中率指标
+template <template <typename, typename, typename> class Policy>
+void runPolicy(Runner &runner, const char *impl, std::size_t n, const std::vector<std::uint64_t> &trace) {
+    const std::size_t capacity = std::max<std::size_t>(1, n / 10);
+    std::size_t hits = 0;
+    Result &result = runner.measure(
+        {"cache", "get_or_put/zipfian", impl, "int64", n, trace.size()},
+        [&] { return std::make_unique<Cache<std::uint64_t, std::uint64_t, Policy>>(capacity); },
+        [&](std::unique_ptr<Cache<std::uint64_t, std::uint64_t, Policy>> &cache) {
+            for (std::uint64_t key : trace) {
+                if (!cache->get(key)) cache->put(key, key);
+            }
+            hits = cache->hitCount();
+        });
+    result.metrics.emplace_back("hit_ratio", static_cast<double>(hits) / static_cast<double>(trace.size()));
+}
+
+template <template <typename, typename, typename> class Policy>
+void runSharded(Runner &runner, const char *impl, std::size_t n, unsigned threads,
+                const std::vector<std::uint64_t> &trace) {
+    const std::size_t capacity = std::max<std::size_t>(1, n / 10);
+    std::size_t hits = 0;
+    using Sharded = ShardedCache<std::uint64_t, std::uint64_t, Policy>;
+    Result &result = runner.measure(
+        {"cache", "sharded/zipfian/threads" + std::to_string(threads), impl, "int64", n, trace.size() * threads},
+        [&] { return std::make_unique<Sharded>(capacity, 64); },
+        [&](std::unique_ptr<Sharded> &cache) {
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < threads; ++t) {
+                workers.emplace_back([&, t] {
+                    // 每个线程从 trace 的不同偏移开始，避免所有线程步调一致
+                    const std::size_t offset = trace.size() / threads * t;
+                    for (std::size_t i = 0; i < trace.size(); ++i) {
+                        const std::uint64_t key = trace[(i + offset) % trace.size()];
+                        if (!cache->get(key)) cache->put(key, key);
+                    }
+                });
+            }
+            for (std::thread &worker : workers) worker.join();
+            hits = cache->hitCount();
+        });
+    result.metrics.emplace_back("hit_ratio",
+                                static_cast<double>(hits) / static_cast<double>(trace.size() * threads));
+}
+
+}  // namespace
+
+void cacheSuite(Runner &runner) {
+    for (std::size_t n : runner.config().sizes) {
+        const std::vector<std::uint64_t> trace = makeIndices(Pattern::Zipfian, n, 4 * n, runner.config().seed);
+        runPolicy<LruPolicy>(runner, "LRU", n, trace);
+        runPolicy<SlruPolicy>(runner, "SLRU", n, trace);
+        runPolicy<WTinyLfuPolicy>(runner, "W-TinyLFU", n, trace);
+        for (unsigned threads : runner.config().threads) {
+            runSharded<LruPolicy>(runner, "LRU", n, threads, trace);
+            runSharded<WTinyLfuPolicy>(runner, "W-TinyLFU", n, threads, trace);
+        }
+    }
+}
+
+}  // namespace bench
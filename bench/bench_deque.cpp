@@ -0,0 +1,79 @@
+#include <deque>
+#include <optional>
+
+#include "deque.cpp"
+#include "harness.h"
+#include "workloads.h"
+
+namespace bench {
+namespace {
+
+template <typename T, typename Container>
+void runDeque(Runner &runner, const char *impl, std::size_t n) {
+    using E = Element<T>;
+
+    runner.measure({"deque", "push_back/sequential", impl, E::name, n, n},
+                   [] { return Container(); },
+                   [&](Container &d) {
+                       for (std::size_t i = 0; i < n; ++i) d.push_back(E::make(i));
+                       doNotOptimize(d);
+                   });
+
+    runner.measure({"deque", "push_front/sequential", impl, E::name, n, n},
+                   [] { return Container(); },
+                   [&](Container &d) {
+                       for (std::size_t i = 0; i < n; ++i) d.push_front(E::make(i));
+                       doNotOptimize(d);
+                   });
+
+    // 两端交替进出，长度保持为 n
+    runner.measure({"deque", "churn/push_back+pop_front", impl, E::name, n, n},
+                   [&] {
+                       Container d;
+                       for (std::size_t i = 0; i < n; ++i) d.push_back(E::make(i));
+                       return d;
+                   },
+                   [&](Container &d) {
+                       for (std::size_t i = 0; i < n; ++i) {
+                           d.push_back(E::make(i));
+                           d.pop_front();
+                       }
+                       doNotOptimize(d);
+                   });
+
+    std::optional<Container> filled;
+    for (Pattern pattern : kPatterns) {
+        const Case c{"deque", std::string("read/") + patternName(pattern), impl, E::name, n, n};
+        if (runner.skip(c)) continue;
+        if (!filled) {
+            filled.emplace();
+            for (std::size_t i = 0; i < n; ++i) filled->push_back(E::make(i));
+        }
+        const Container &d = *filled;
+        const std::vector<std::uint64_t> indices = makeIndices(pattern, n, n, runner.config().seed);
+        runner.measure(c, [&] {
+            std::uint64_t sum = 0;
+            for (std::uint64_t index : indices) sum += E::key(d[static_cast<int>(index)]);
+            doNotOptimize(sum);
+        });
+    }
+}
+
+template <typename T>
+void runElement(Runner &runner, std::size_t n) {
+    runDeque<T, Deque<T>>(runner, "Deque", n);
+    runDeque<T, std::deque<T>>(runner, "std::deque", n);
+}
+
+}  // namespace
+
+void dequeSuite(Runner &runner) {
+    for (std::size_t n : runner.config().sizes) {
+        // Deque 的下标是 int
+        if (n > 1000000000) continue;
+        runElement<std::uint64_t>(runner, n);
+        if (n <= runner.config().largeElementLimit) runElement<Large>(runner, n);
+    }
+}
+
+}  // namespace bench
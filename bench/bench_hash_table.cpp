@@ -0,0 +1,117 @@
+#include <optional>
+#include <unordered_map>
+
+#include "harness.h"
+#include "hash_table.cpp"
+#include "workloads.h"
+
+namespace bench {
+namespace {
+
+template <typename K>
+struct HashTableOps {
+    using Map = HashTable<K, std::uint64_t, typename Element<K>::hash>;
+    static const char *name() { return "HashTable"; }
+    static void insert(Map &map, const K &key, std::uint64_t value) { map.insert(key, value); }
+    static const std::uint64_t *find(Map &map, const K &key) { return map.find(key); }
+    static void erase(Map &map, const K &key) { map.erase(key); }
+};
+
+template <typename K>
+struct StdMapOps {
+    using Map = std::unordered_map<K, std::uint64_t, typename Element<K>::hash>;
+    static const char *name() { return "std::unordered_map"; }
+    static void insert(Map &map, const K &key, std::uint64_t value) { map.emplace(key, value); }
+    static const std::uint64_t *find(Map &map, const K &key) {
+        auto it = map.find(key);
+        return it == map.end() ? nullptr : &it->second;
+    }
+    static void erase(Map &map, const K &key) { map.erase(key); }
+};
+
+template <typename K, typename Ops>
+void runHash(Runner &runner, std::size_t n) {
+    using E = Element<K>;
+    using Map = typename Ops::Map;
+    const char *impl = Ops::name();
+    const std::uint64_t seed = runner.config().seed;
+
+    // 键取打散后的 64 位值，插入顺序即随机顺序
+    std::vector<K> keys;
+    std::vector<K> missing;
+    auto prepareKeys = [&] {
+        if (!keys.empty()) return;
+        keys.reserve(n);
+        missing.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            keys.push_back(E::make(scramble(i)));
+            missing.push_back(E::make(scramble(i + n)));
+        }
+    };
+    auto filled = [&] {
+        Map map;
+        for (std::size_t i = 0; i < n; ++i) Ops::insert(map, keys[i], i);
+        return map;
+    };
+
+    const Case insertCase{"hash_table", "insert/random", impl, E::name, n, n};
+    if (!runner.skip(insertCase)) {
+        prepareKeys();
+        runner.measure(insertCase, [] { return Map(); },
+                       [&](Map &map) {
+                           for (std::size_t i = 0; i < n; ++i) Ops::insert(map, keys[i], i);
+                           doNotOptimize(map);
+                       });
+    }
+
+    std::optional<Map> shared;
+    for (Pattern pattern : kPatterns) {
+        const Case c{"hash_table", std::string("find_hit/") + patternName(pattern), impl, E::name, n, n};
+        if (runner.skip(c)) continue;
+        prepareKeys();
+        if (!shared) shared.emplace(filled());
+        const std::vector<std::uint64_t> indices = makeIndices(pattern, n, n, seed);
+        runner.measure(c, [&] {
+            std::uint64_t sum = 0;
+            for (std::uint64_t index : indices) sum += *Ops::find(*shared, keys[index]);
+            doNotOptimize(sum);
+        });
+    }
+
+    const Case missCase{"hash_table", "find_miss/random", impl, E::name, n, n};
+    if (!runner.skip(missCase)) {
+        prepareKeys();
+        if (!shared) shared.emplace(filled());
+        runner.measure(missCase, [&] {
+            std::size_t found = 0;
+            for (const K &key : missing) found += Ops::find(*shared, key) != nullptr;
+            doNotOptimize(found);
+        });
+    }
+
+    const Case eraseCase{"hash_table", "erase/random", impl, E::name, n, n};
+    if (!runner.skip(eraseCase)) {
+        prepareKeys();
+        runner.measure(eraseCase, filled, [&](Map &map) {
+            for (const K &key : keys) Ops::erase(map, key);
+            doNotOptimize(map);
+        });
+    }
+}
+
+template <typename K>
+void runElement(Runner &runner, std::size_t n) {
+    runHash<K, HashTableOps<K>>(runner, n);
+    runHash<K, StdMapOps<K>>(runner, n);
+}
+
+}  // namespace
+
+void hashTableSuite(Runner &runner) {
+    for (std::size_t n : runner.config().sizes) {
+        runElement<std::uint64_t>(runner, n);
+        if (n <= runner.config().largeElementLimit) runElement<Large>(runner, n);
+    }
+}
+
+}  // namespace bench
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <list>
+
+#include "harness.h"
+#include "list.cpp"
+#include "unrolled_list.cpp"
+#include "workloads.h"
+
+namespace bench {
+namespace {
+
+// 三种链表的统一适配：List 没有迭代器，遍历用一次查找不存在的值来完成
+template <typename T>
+struct ListOps {
+    static const char *name() { return "List"; }
+    static bool traverseMiss(List<T> &list, const T &missing) { return list.find(missing) != nullptr; }
+};
+
+template <typename T>
+struct UnrolledOps {
+    static const char *name() { return "UnrolledList"; }
+    static bool traverseMiss(UnrolledList<T> &list, const T &missing) { return list.find(missing) != list.end(); }
+};
+
+template <typename T>
+struct StdListOps {
+    static const char *name() { return "std::list"; }
+    static bool traverseMiss(std::list<T> &list, const T &missing) {
+        return std::find(list.begin(), list.end(), missing) != list.end();
+    }
+};
+
+template <typename T, typename Container>
+Container filledList(std::size_t n) {
+    Container list;
+    for (std::size_t i = 0; i < n; ++i) list.push_back(Element<T>::make(i));
+    return list;
+}
+
+template <typename T, typename Container, typename Ops>
+void runList(Runner &runner, std::size_t n) {
+    using E = Element<T>;
+    const char *impl = Ops::name();
+
+    runner.measure({"list", "push_back/sequential", impl, E::name, n, n},
+                   [] { return Container(); },
+                   [&](Container &list) {
+                       for (std::size_t i = 0; i < n; ++i) list.push_back(E::make(i));
+                       doNotOptimize(list);
+                   });
+
+    // 先 push 再 pop 的队列式抖动，长度保持为 n
+    runner.measure({"list", "churn/push_back+pop_front", impl, E::name, n, n},
+                   [&] { return filledList<T, Container>(n); },
+                   [&](Container &list) {
+                       for (std::size_t i = 0; i < n; ++i) {
+                           list.push_back(E::make(i));
+                           list.pop_front();
+                       }
+                       doNotOptimize(list);
+                   });
+
+    runner.measure({"list", "traverse", impl, E::name, n, n},
+                   [&] { return filledList<T, Container>(n); },
+                   [&](Container &list) { doNotOptimize(Ops::traverseMiss(list, E::make(n))); });
+
+    runner.measure({"list", "teardown", impl, E::name, n, n},
+                   [&] { return filledList<T, Container>(n); },
+                   [&](Container &list) {
+                       list.clear();
+                       doNotOptimize(list);
+                   });
+}
+
+// operator[] 顺序扫描：List 每次从头走是 O(n^2)，所以只在小规模上运行
+template <typename T>
+void runIndexSweep(Runner &runner, std::size_t n) {
+    using E = Element<T>;
+    const Case plain{"list", "index_sweep", "List", E::name, n, n};
+    if (n <= 10000 && !runner.skip(plain)) {
+        List<T> list = filledList<T, List<T>>(n);
+        runner.measure(plain, [&] {
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < n; ++i) sum += E::key(list[i]);
+            doNotOptimize(sum);
+        });
+    }
+    const Case unrolledCase{"list", "index_sweep", "UnrolledList", E::name, n, n};
+    if (!runner.skip(unrolledCase)) {
+        UnrolledList<T> unrolled = filledList<T, UnrolledList<T>>(n);
+        runner.measure(unrolledCase, [&] {
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < n; ++i) sum += E::key(unrolled[i]);
+            doNotOptimize(sum);
+        });
+    }
+}
+
+// 一边遍历一边在迭代器处随机插入或删除，考察定位之后 O(1) 的 insert / erase
+template <typename T, typename Container>
+void runIteratorEdits(Runner &runner, const char *impl, std::size_t n) {
+    using E = Element<T>;
+    const Case c{"list", "iterator_insert_erase/random", impl, E::name, n, n};
+    if (runner.skip(c)) return;
+    const std::vector<std::uint64_t> coins = makeIndices(Pattern::Random, 4, n, runner.config().seed);
+    runner.measure(c,
+                   [&] { return filledList<T, Container>(n); },
+                   [&](Container &list) {
+                       auto it = list.begin();
+                       for (std::size_t i = 0; i < n; ++i) {
+                           if (it == list.end()) it = list.begin();
+                           switch (coins[i]) {
+                           case 0: it = list.insert(it, E::make(i)); ++it; break;
+                           case 1: if (it != list.end()) it = list.erase(it); break;
+                           default: ++it; break;
+                           }
+                       }
+                       doNotOptimize(list);
+                   });
+}
+
+template <typename T>
+void runElement(Runner &runner, std::size_t n) {
+    runList<T, List<T>, ListOps<T>>(runner, n);
+    runList<T, UnrolledList<T>, UnrolledOps<T>>(runner, n);
+    runList<T, std::list<T>, StdListOps<T>>(runner, n);
+    runIndexSweep<T>(runner, n);
+    runIteratorEdits<T, UnrolledList<T>>(runner, "UnrolledList", n);
+    runIteratorEdits<T, std::list<T>>(runner, "std::list", n);
+}
+
+}  // namespace
+
+void listSuite(Runner &runner) {
+    for (std::size_t n : runner.config().sizes) {
+        runElement<std::uint64_t>(runner, n);
+        if (n <= runner.config().largeElementLimit) runElement<Large>(runner, n);
+    }
+}
+
+}  // namespace bench
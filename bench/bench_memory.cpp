@@ -0,0 +1,172 @@
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+
+#include "harness.h"
+#include "hash_table.cpp"
+#include "list.cpp"
+#include "memory_resources.h"
+#include "rbtree.c++"
+#include "unrolled_list.cpp"
+#include "vector.cpp"
+#include "workloads.h"
+
+namespace bench {
+namespace {
+
+// 每个用例处理约这么多元素：小规模时模拟大量短请求，大规模时至少两个请求
+constexpr std::size_t kElementsPerCase = 1000000;
+
+struct PmrContainers {
+    template <typename T>
+    using Vector = pmr::Vector<T>;
+    template <typename T>
+    using List = pmr::List<T>;
+    template <typename T>
+    using UnrolledList = pmr::UnrolledList<T>;
+    template <typename K, typename V>
+    using HashTable = pmr::HashTable<K, V>;
+    template <typename K, typename V>
+    using RedBlackTree = pmr::RedBlackTree<K, V>;
+
+    void endRequest() {}
+    std::size_t reserved() const { return 0; }
+};
+
+struct StdAllocator {
+    static constexpr const char *name = "std::allocator";
+
+    template <typename T>
+    using Vector = ::Vector<T>;
+    template <typename T>
+    using List = ::List<T>;
+    template <typename T>
+    using UnrolledList = ::UnrolledList<T>;
+    template <typename K, typename V>
+    using HashTable = ::HashTable<K, V>;
+    template <typename K, typename V>
+    using RedBlackTree = ::RedBlackTree<K, V>;
+
+    void endRequest() {}
+    std::size_t reserved() const { return 0; }
+};
+
+// 只多一层虚调用，用来区分 pmr 本身的开销和资源策略带来的差异
+struct NewDeleteResource : PmrContainers {
+    static constexpr const char *name = "pmr/new_delete";
+    std::pmr::memory_resource *resource() { return std::pmr::new_delete_resource(); }
+};
+
+struct Arena : PmrContainers {
+    static constexpr const char *name = "pmr/MonotonicArena";
+    MonotonicArena arena;
+    std::pmr::memory_resource *resource() { return &arena; }
+    void endRequest() { arena.reset(); }
+    std::size_t reserved() const { return arena.bytesReserved(); }
+};
+
+struct StdMonotonic : PmrContainers {
+    static constexpr const char *name = "pmr/std::monotonic_buffer_resource";
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::memory_resource *resource() { return &arena; }
+    void endRequest() { arena.release(); }
+};
+
+// 池在请求之间保留，容器析构时节点回到空闲链表供下一个请求复用
+struct Pool : PmrContainers {
+    static constexpr const char *name = "pmr/SizeClassPool";
+    SizeClassPool pool;
+    std::pmr::memory_resource *resource() { return &pool; }
+    std::size_t reserved() const { return pool.bytesReserved(); }
+};
+
+struct StdPool : PmrContainers {
+    static constexpr const char *name = "pmr/std::unsynchronized_pool_resource";
+    std::pmr::unsynchronized_pool_resource pool;
+    std::pmr::memory_resource *resource() { return &pool; }
+};
+
+template <typename Container, typename Memory>
+Container makeContainer(Memory &memory) {
+    if constexpr (std::is_same<Memory, StdAllocator>::value) {
+        return Container();
+    } else {
+        return Container(typename Container::allocator_type(memory.resource()));
+    }
+}
+
+// 每个请求在自己的作用域里构建容器、查询、随后整体丢弃；请求结束时调用 endRequest 回收
+template <typename Memory, typename Request>
+void runRequests(Runner &runner, const char *workload, std::size_t n, Request request) {
+    const std::size_t requests = std::max<std::size_t>(2, kElementsPerCase / n);
+    std::size_t reserved = 0;
+    Result &result = runner.measure({"memory", workload, Memory::name, "int64", n, requests * n},
+                                    [] { return std::make_unique<Memory>(); },
+                                    [&](std::unique_ptr<Memory> &memory) {
+                                        for (std::size_t r = 0; r < requests; ++r) {
+                                            request(*memory);
+                                            memory->endRequest();
+                                        }
+                                        reserved = memory->reserved();
+                                    });
+    if (reserved) result.metrics.emplace_back("upstream_bytes", static_cast<double>(reserved));
+}
+
+template <typename Memory>
+void runMemory(Runner &runner, std::size_t n, const std::vector<std::uint64_t> &keys) {
+    runRequests<Memory>(runner, "request/vector", n, [&](Memory &memory) {
+        auto v = makeContainer<typename Memory::template Vector<std::uint64_t>>(memory);
+        for (std::uint64_t key : keys) v.push_back(key);
+        std::uint64_t sum = 0;
+        for (std::uint64_t value : v) sum += value;
+        doNotOptimize(sum);
+    });
+
+    runRequests<Memory>(runner, "request/list", n, [&](Memory &memory) {
+        auto list = makeContainer<typename Memory::template List<std::uint64_t>>(memory);
+        for (std::uint64_t key : keys) list.push_back(key);
+        doNotOptimize(list.getSize());
+    });
+
+    runRequests<Memory>(runner, "request/unrolled_list", n, [&](Memory &memory) {
+        auto list = makeContainer<typename Memory::template UnrolledList<std::uint64_t>>(memory);
+        for (std::uint64_t key : keys) list.push_back(key);
+        std::uint64_t sum = 0;
+        for (std::uint64_t value : list) sum += value;
+        doNotOptimize(sum);
+    });
+
+    runRequests<Memory>(runner, "request/hash_table", n, [&](Memory &memory) {
+        auto map = makeContainer<typename Memory::template HashTable<std::uint64_t, std::uint64_t>>(memory);
+        for (std::uint64_t key : keys) map.insert(key, key);
+        std::uint64_t sum = 0;
+        for (std::uint64_t key : keys) sum += *map.find(key);
+        doNotOptimize(sum);
+    });
+
+    runRequests<Memory>(runner, "request/rbtree", n, [&](Memory &memory) {
+        auto tree = makeContainer<typename Memory::template RedBlackTree<std::uint64_t, std::uint64_t>>(memory);
+        for (std::uint64_t key : keys) tree.insert(key, key);
+        std::uint64_t sum = 0;
+        for (std::uint64_t key : keys) sum += *tree.at(key);
+        doNotOptimize(sum);
+    });
+}
+
+}  // namespace
+
+// 按请求构建再丢弃：默认分配器、pmr 转发到 new/delete、自带的单调 arena 与分级池、以及标准库的两种资源
+void memorySuite(Runner &runner) {
+    for (std::size_t n : runner.config().sizes) {
+        std::vector<std::uint64_t> keys(n);
+        for (std::size_t i = 0; i < n; ++i) keys[i] = scramble(i);
+        runMemory<StdAllocator>(runner, n, keys);
+        runMemory<NewDeleteResource>(runner, n, keys);
+        runMemory<Arena>(runner, n, keys);
+        runMemory<StdMonotonic>(runner, n, keys);
+        runMemory<Pool>(runner, n, keys);
+        runMemory<StdPool>(runner, n, keys);
+    }
+}
+
+}  // namespace bench
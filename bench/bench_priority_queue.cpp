@@ -0,0 +1,221 @@
+#include <functional>
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "harness.h"
+#include "heap.cpp"
+#include "timing_wheel.cpp"
+#include "workloads.h"
+
+namespace bench {
+namespace {
+
+template <typename T, typename Queue>
+void runPushPop(Runner &runner, const char *impl, std::size_t n) {
+    using E = Element<T>;
+    const std::vector<std::uint64_t> keys = makeIndices(Pattern::Random, ~std::uint64_t(0), n, runner.config().seed);
+    runner.measure({"priority_queue", "push+pop/random", impl, E::name, n, 2 * n},
+                   [] { return Queue(); },
+                   [&](Queue &q) {
+                       for (std::uint64_t key : keys) q.push(E::make(key));
+                       std::uint64_t sum = 0;
+                       while (!q.empty()) {
+                           sum += E::key(q.top());
+                           q.pop();
+                       }
+                       doNotOptimize(sum);
+                   });
+}
+
+struct Event {
+    std::uint64_t time;
+    std::uint64_t id;
+};
+
+struct EventLater {
+    bool operator()(const Event &a, const Event &b) const { return a.time > b.time; }
+};
+
+struct EventTime {
+    std::uint64_t operator()(const Event &e) const { return e.time; }
+};
+
+// 经典 hold 模型：队列里始终有 n 个事件，每步取出最早的事件并安排一个随机延迟之后的新事件
+template <typename Queue>
+void runHold(Runner &runner, const char *impl, std::size_t n) {
+    const std::size_t steps = n;
+    const std::vector<std::uint64_t> delays = makeIndices(Pattern::Random, 1000, n + steps, runner.config().seed);
+    runner.measure({"priority_queue", "event_simulation/hold", impl, "event16", n, steps},
+                   [&] {
+                       Queue q;
+                       for (std::size_t i = 0; i < n; ++i) q.push(Event{delays[i] + 1, i});
+                       return q;
+                   },
+                   [&](Queue &q) {
+                       for (std::size_t i = 0; i < steps; ++i) {
+                           const Event e = q.top();
+                           q.pop();
+                           q.push(Event{e.time + delays[n + i] + 1, e.id});
+                       }
+                       doNotOptimize(q.top());
+                   });
+}
+
+struct Graph {
+    std::vector<std::size_t> offsets;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;  // (目标顶点, 权重)
+};
+
+Graph randomGraph(std::size_t n, std::size_t degree, std::uint64_t seed) {
+    Rng rng(seed);
+    Graph graph;
+    graph.offsets.reserve(n + 1);
+    graph.edges.reserve(n * degree);
+    for (std::size_t v = 0; v < n; ++v) {
+        graph.offsets.push_back(graph.edges.size());
+        // 保证连通：先连向下一个顶点
+        graph.edges.emplace_back(static_cast<std::uint32_t>((v + 1) % n), static_cast<std::uint32_t>(1 + rng.below(1000)));
+        for (std::size_t d = 1; d < degree; ++d) {
+            graph.edges.emplace_back(static_cast<std::uint32_t>(rng.below(n)), static_cast<std::uint32_t>(1 + rng.below(1000)));
+        }
+    }
+    graph.offsets.push_back(graph.edges.size());
+    return graph;
+}
+
+template <typename Queue>
+void runDijkstra(Runner &runner, const char *impl, std::size_t n, const Graph &graph) {
+    runner.measure({"priority_queue", "dijkstra/degree4", impl, "event16", n, n}, [&] {
+        std::vector<std::uint64_t> dist(n, ~std::uint64_t(0));
+        Queue q;
+        dist[0] = 0;
+        q.push(Event{0, 0});
+        while (!q.empty()) {
+            const Event e = q.top();
+            q.pop();
+            if (e.time != dist[e.id]) continue;
+            for (std::size_t i = graph.offsets[e.id]; i < graph.offsets[e.id + 1]; ++i) {
+                const std::uint64_t candidate = e.time + graph.edges[i].second;
+                const std::uint32_t to = graph.edges[i].first;
+                if (candidate < dist[to]) {
+                    dist[to] = candidate;
+                    q.push(Event{candidate, to});
+                }
+            }
+        }
+        doNotOptimize(dist.back());
+    });
+}
+
+struct FireCounter {
+    std::uint64_t *fired = nullptr;
+    void operator()() const { ++*fired; }
+};
+
+struct TimerEntry {
+    std::uint64_t expiry;
+    std::uint64_t id;
+    bool operator<(const TimerEntry &other) const { return expiry > other.expiry; }
+};
+
+// 以堆实现定时器：取消只能打墓碑标记，过期时跳过
+struct HeapTimers {
+    MyPriorityQueue<TimerEntry> heap;
+    std::vector<bool> cancelled;
+    std::uint64_t fired = 0;
+
+    void arm(std::uint64_t expiry, std::uint64_t id) {
+        heap.push(TimerEntry{expiry, id});
+        cancelled.push_back(false);
+    }
+    void cancel(std::uint64_t id) { cancelled[id] = true; }
+    void advance(std::uint64_t now) {
+        while (!heap.empty() && heap.top().expiry <= now) {
+            if (!cancelled[heap.top().id]) ++fired;
+            heap.pop();
+        }
+    }
+};
+
+struct WheelTimers {
+    TimingWheel<FireCounter> wheel;
+    std::vector<TimingWheel<FireCounter>::TimerId> ids;
+    std::uint64_t fired = 0;
+
+    void arm(std::uint64_t expiry, std::uint64_t) { ids.push_back(wheel.schedule(expiry, FireCounter{&fired})); }
+    void cancel(std::uint64_t id) { wheel.cancel(ids[id]); }
+    void advance(std::uint64_t now) { wheel.advance(now); }
+};
+
+template <typename Timers>
+void runTimers(Runner &runner, const char *impl, std::size_t n) {
+    const std::vector<std::uint64_t> delays = makeIndices(Pattern::Random, 1 << 20, n, runner.config().seed);
+    auto armed = [&] {
+        auto timers = std::make_unique<Timers>();
+        for (std::size_t i = 0; i < n; ++i) timers->arm(delays[i] + 1, i);
+        return timers;
+    };
+
+    runner.measure({"timers", "arm", impl, "timer", n, n}, [] { return std::make_unique<Timers>(); },
+                   [&](std::unique_ptr<Timers> &timers) {
+                       for (std::size_t i = 0; i < n; ++i) timers->arm(delays[i] + 1, i);
+                       doNotOptimize(*timers);
+                   });
+
+    runner.measure({"timers", "cancel_half", impl, "timer", n, n / 2}, armed, [&](std::unique_ptr<Timers> &timers) {
+        for (std::size_t i = 0; i < n; i += 2) timers->cancel(i);
+        doNotOptimize(*timers);
+    });
+
+    runner.measure({"timers", "expire_all", impl, "timer", n, n},
+                   [&] {
+                       auto timers = armed();
+                       for (std::size_t i = 0; i < n; i += 2) timers->cancel(i);
+                       return timers;
+                   },
+                   [&](std::unique_ptr<Timers> &timers) {
+                       // 以 1024 tick 为步长推进，模拟事件循环的周期性 tick
+                       for (std::uint64_t now = 1024; now <= (1 << 20) + 1024; now += 1024) timers->advance(now);
+                       doNotOptimize(timers->fired);
+                   });
+}
+
+}  // namespace
+
+void priorityQueueSuite(Runner &runner) {
+    for (std::size_t n : runner.config().sizes) {
+        runPushPop<std::uint64_t, MyPriorityQueue<std::uint64_t>>(runner, "MyPriorityQueue", n);
+        runPushPop<std::uint64_t, std::priority_queue<std::uint64_t>>(runner, "std::priority_queue", n);
+        if (n <= runner.config().largeElementLimit) {
+            runPushPop<Large, MyPriorityQueue<Large>>(runner, "MyPriorityQueue", n);
+            runPushPop<Large, std::priority_queue<Large>>(runner, "std::priority_queue", n);
+        }
+
+        using BinaryEvents = MyPriorityQueue<Event, std::vector<Event>, EventLater>;
+        using StdEvents = std::priority_queue<Event, std::vector<Event>, EventLater>;
+        using RadixEvents = PriorityQueue<Event, RadixHeapPolicy<EventTime>>;
+        runHold<BinaryEvents>(runner, "MyPriorityQueue", n);
+        runHold<StdEvents>(runner, "std::priority_queue", n);
+        runHold<RadixEvents>(runner, "RadixHeap", n);
+
+        Graph graph;
+        auto needGraph = [&](const char *impl) {
+            const Case c{"priority_queue", "dijkstra/degree4", impl, "event16", n, n};
+            if (runner.config().listOnly || !runner.enabled(c)) return;
+            if (graph.offsets.empty()) graph = randomGraph(n, 4, runner.config().seed);
+        };
+        needGraph("MyPriorityQueue");
+        runDijkstra<BinaryEvents>(runner, "MyPriorityQueue", n, graph);
+        needGraph("std::priority_queue");
+        runDijkstra<StdEvents>(runner, "std::priority_queue", n, graph);
+        needGraph("RadixHeap");
+        runDijkstra<RadixEvents>(runner, "RadixHeap", n, graph);
+
+        runTimers<HeapTimers>(runner, "MyPriorityQueue", n);
+        runTimers<WheelTimers>(runner, "TimingWheel", n);
+    }
+}
+
+}  // namespace bench
@@ -0,0 +1,101 @@
+#include <map>
+#include <memory>
+
+#include "harness.h"
+#include "rbtree.c++"
+#include "workloads.h"
+
+namespace bench {
+namespace {
+
+template <typename K>
+struct RedBlackTreeOps {
+    using Map = RedBlackTree<K, std::uint64_t>;
+    static const char *name() { return "RedBlackTree"; }
+    static void insert(Map &map, const K &key, std::uint64_t value) { map.insert(key, value); }
+    static const std::uint64_t *find(Map &map, const K &key) { return map.at(key); }
+    static void erase(Map &map, const K &key) { map.remove(key); }
+};
+
+template <typename K>
+struct StdMapOps {
+    using Map = std::map<K, std::uint64_t>;
+    static const char *name() { return "std::map"; }
+    static void insert(Map &map, const K &key, std::uint64_t value) { map.emplace(key, value); }
+    static const std::uint64_t *find(Map &map, const K &key) {
+        auto it = map.find(key);
+        return it == map.end() ? nullptr : &it->second;
+    }
+    static void erase(Map &map, const K &key) { map.erase(key); }
+};
+
+// RedBlackTree 不可移动，状态统一用 unique_ptr 持有
+template <typename K, typename Ops>
+void runTree(Runner &runner, std::size_t n) {
+    using E = Element<K>;
+    using Map = typename Ops::Map;
+    const char *impl = Ops::name();
+    const std::uint64_t seed = runner.config().seed;
+
+    std::vector<K> keys;
+    auto prepareKeys = [&] {
+        if (!keys.empty()) return;
+        keys.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) keys.push_back(E::make(scramble(i)));
+    };
+    auto filled = [&] {
+        auto map = std::make_unique<Map>();
+        for (std::size_t i = 0; i < n; ++i) Ops::insert(*map, keys[i], i);
+        return map;
+    };
+
+    const Case insertCase{"rbtree", "insert/random", impl, E::name, n, n};
+    if (!runner.skip(insertCase)) {
+        prepareKeys();
+        runner.measure(insertCase, [] { return std::make_unique<Map>(); },
+                       [&](std::unique_ptr<Map> &map) {
+                           for (std::size_t i = 0; i < n; ++i) Ops::insert(*map, keys[i], i);
+                           doNotOptimize(*map);
+                       });
+    }
+
+    std::unique_ptr<Map> shared;
+    for (Pattern pattern : kPatterns) {
+        const Case c{"rbtree", std::string("find/") + patternName(pattern), impl, E::name, n, n};
+        if (runner.skip(c)) continue;
+        prepareKeys();
+        if (!shared) shared = filled();
+        const std::vector<std::uint64_t> indices = makeIndices(pattern, n, n, seed);
+        runner.measure(c, [&] {
+            std::uint64_t sum = 0;
+            for (std::uint64_t index : indices) sum += *Ops::find(*shared, keys[index]);
+            doNotOptimize(sum);
+        });
+    }
+
+    const Case eraseCase{"rbtree", "erase/random", impl, E::name, n, n};
+    if (!runner.skip(eraseCase)) {
+        prepareKeys();
+        runner.measure(eraseCase, filled, [&](std::unique_ptr<Map> &map) {
+            for (const K &key : keys) Ops::erase(*map, key);
+            doNotOptimize(*map);
+        });
+    }
+}
+
+template <typename K>
+void runElement(Runner &runner, std::size_t n) {
+    runTree<K, RedBlackTreeOps<K>>(runner, n);
+    runTree<K, StdMapOps<K>>(runner, n);
+}
+
+}  // namespace
+
+void rbtreeSuite(Runner &runner) {
+    for (std::size_t n : runner.config().sizes) {
+        runElement<std::uint64_t>(runner, n);
+        if (n <= runner.config().largeElementLimit) runElement<Large>(runner, n);
+    }
+}
+
+}  // namespace bench
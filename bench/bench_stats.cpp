@@ -0,0 +1,160 @@
+#include <memory>
+#include <type_traits>
+
+#include "deque.cpp"
+#include "harness.h"
+#include "hash_table.cpp"
+#include "heap.cpp"
+#include "rbtree.c++"
+#include "vector.cpp"
+#include "workloads.h"
+
+namespace bench {
+namespace {
+
+using Entry = std::pair<const std::uint64_t, std::uint64_t>;
+
+template <typename Stats>
+using StatsVector = Vector<std::uint64_t, std::allocator<std::uint64_t>, Stats>;
+template <typename Stats>
+using StatsDeque = Deque<std::uint64_t, std::allocator<std::uint64_t>, Stats>;
+template <typename Stats>
+using StatsHashTable = HashTable<std::uint64_t, std::uint64_t, std::hash<std::uint64_t>, std::allocator<Entry>, Stats>;
+template <typename Stats>
+using StatsTree = RedBlackTree<std::uint64_t, std::uint64_t, std::allocator<Entry>, Stats>;
+
+// 关闭统计时容器布局不变：NullStats 经空基类优化后不占空间
+static_assert(std::is_empty<NullStats>::value, "NullStats must stay empty");
+static_assert(sizeof(StatsVector<NullStats>) == 3 * sizeof(void *), "Vector grew with NullStats");
+static_assert(sizeof(StatsDeque<NullStats>) == 5 * sizeof(void *), "Deque grew with NullStats");
+static_assert(sizeof(StatsTree<NullStats>) == 3 * sizeof(void *), "RedBlackTree grew with NullStats");
+
+template <typename Stats>
+const char *statsName() {
+    return Stats::enabled ? "ContainerStats" : "NullStats";
+}
+
+// 只有打开统计的一侧才有数据，附在结果里便于对照埋点本身的开销
+void addMetrics(Result &result, const StatsSnapshot &s) {
+    if (s.operations == 0) return;
+    if (s.grows) {
+        result.metrics.emplace_back("grows", static_cast<double>(s.grows));
+        result.metrics.emplace_back("grow_pause_p99_ns", static_cast<double>(s.growPauseNanos.percentile(0.99)));
+        result.metrics.emplace_back("grow_pause_max_ns", static_cast<double>(s.growPauseNanos.max()));
+    }
+    if (s.chainLength.count()) {
+        result.metrics.emplace_back("chain_mean", s.chainLength.mean());
+        result.metrics.emplace_back("chain_max", static_cast<double>(s.chainLength.max()));
+    }
+    if (s.depth.count()) {
+        result.metrics.emplace_back("depth_mean", s.depth.mean());
+        result.metrics.emplace_back("rotations_per_op", static_cast<double>(s.rotations) / s.operations);
+    }
+    if (s.siftDistance.count()) result.metrics.emplace_back("sift_mean", s.siftDistance.mean());
+}
+
+template <typename Stats>
+void runVector(Runner &runner, std::size_t n) {
+    StatsSnapshot snapshot;
+    Result &result = runner.measure({"stats", "vector/push_back", statsName<Stats>(), "int64", n, n},
+                                    [] { return StatsVector<Stats>(); },
+                                    [&](StatsVector<Stats> &v) {
+                                        for (std::size_t i = 0; i < n; ++i) v.push_back(i);
+                                        doNotOptimize(v);
+                                        snapshot = v.stats();
+                                    });
+    addMetrics(result, snapshot);
+}
+
+template <typename Stats>
+void runDeque(Runner &runner, std::size_t n) {
+    StatsSnapshot snapshot;
+    Result &result = runner.measure({"stats", "deque/push_back+pop_front", statsName<Stats>(), "int64", n, 2 * n},
+                                    [] { return StatsDeque<Stats>(); },
+                                    [&](StatsDeque<Stats> &d) {
+                                        for (std::size_t i = 0; i < n; ++i) d.push_back(i);
+                                        std::uint64_t sum = 0;
+                                        while (!d.empty()) {
+                                            sum += d[0];
+                                            d.pop_front();
+                                        }
+                                        doNotOptimize(sum);
+                                        snapshot = d.stats();
+                                    });
+    addMetrics(result, snapshot);
+}
+
+template <typename Stats>
+void runHashTable(Runner &runner, std::size_t n, const std::vector<std::uint64_t> &keys) {
+    using Map = StatsHashTable<Stats>;
+    StatsSnapshot snapshot;
+    Result &result = runner.measure({"stats", "hash_table/insert+find", statsName<Stats>(), "int64", n, 2 * n},
+                                    [] { return Map(); },
+                                    [&](Map &map) {
+                                        for (std::uint64_t key : keys) map.insert(key, key);
+                                        std::uint64_t sum = 0;
+                                        for (std::uint64_t key : keys) sum += *map.find(key);
+                                        doNotOptimize(sum);
+                                        snapshot = map.stats();
+                                    });
+    addMetrics(result, snapshot);
+}
+
+template <typename Stats>
+void runRBTree(Runner &runner, std::size_t n, const std::vector<std::uint64_t> &keys) {
+    using Tree = StatsTree<Stats>;
+    StatsSnapshot snapshot;
+    Result &result = runner.measure({"stats", "rbtree/insert+find", statsName<Stats>(), "int64", n, 2 * n},
+                                    [] { return std::make_unique<Tree>(); },
+                                    [&](std::unique_ptr<Tree> &tree) {
+                                        for (std::uint64_t key : keys) tree->insert(key, key);
+                                        std::uint64_t sum = 0;
+                                        for (std::uint64_t key : keys) sum += *tree->at(key);
+                                        doNotOptimize(sum);
+                                        snapshot = tree->stats();
+                                    });
+    addMetrics(result, snapshot);
+}
+
+template <typename Stats>
+void runPriorityQueue(Runner &runner, std::size_t n, const std::vector<std::uint64_t> &keys) {
+    using Queue = MyPriorityQueue<std::uint64_t, std::vector<std::uint64_t>, std::less<std::uint64_t>, Stats>;
+    StatsSnapshot snapshot;
+    Result &result = runner.measure({"stats", "priority_queue/push+pop", statsName<Stats>(), "int64", n, 2 * n},
+                                    [] { return Queue(); },
+                                    [&](Queue &q) {
+                                        for (std::uint64_t key : keys) q.push(key);
+                                        std::uint64_t sum = 0;
+                                        while (!q.empty()) {
+                                            sum += q.top();
+                                            q.pop();
+                                        }
+                                        doNotOptimize(sum);
+                                        snapshot = q.stats();
+                                    });
+    addMetrics(result, snapshot);
+}
+
+template <typename Stats>
+void runAll(Runner &runner, std::size_t n, const std::vector<std::uint64_t> &keys) {
+    runVector<Stats>(runner, n);
+    runDeque<Stats>(runner, n);
+    runHashTable<Stats>(runner, n, keys);
+    runRBTree<Stats>(runner, n, keys);
+    runPriorityQueue<Stats>(runner, n, keys);
+}
+
+}  // namespace
+
+// 同一负载分别以 NullStats 与 ContainerStats 实例化：前者应与未埋点的实现一样快（生成代码相同由 ctest 的
+// null_stats_identical_asm 检查），后者给出埋点的代价
+void statsSuite(Runner &runner) {
+    for (std::size_t n : runner.config().sizes) {
+        std::vector<std::uint64_t> keys(n);
+        for (std::size_t i = 0; i < n; ++i) keys[i] = scramble(i);
+        runAll<NullStats>(runner, n, keys);
+        runAll<ContainerStats>(runner, n, keys);
+    }
+}
+
+}  // namespace bench
@@ -0,0 +1,104 @@
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "harness.h"
+#include "vector.cpp"
+#include "workloads.h"
+
+namespace bench {
+namespace {
+
+template <typename T, typename Container>
+void runVector(Runner &runner, const char *impl, std::size_t n) {
+    using E = Element<T>;
+    const std::uint64_t seed = runner.config().seed;
+
+    runner.measure({"vector", "push_back/sequential", impl, E::name, n, n},
+                   [] { return Container(); },
+                   [&](Container &v) {
+                       for (std::size_t i = 0; i < n; ++i) v.push_back(E::make(i));
+                       doNotOptimize(v);
+                   });
+
+    std::optional<Container> filled;
+    auto prepared = [&]() -> const Container & {
+        if (!filled) {
+            filled.emplace();
+            for (std::size_t i = 0; i < n; ++i) filled->push_back(E::make(i));
+        }
+        return *filled;
+    };
+
+    for (Pattern pattern : kPatterns) {
+        const Case c{"vector", std::string("read/") + patternName(pattern), impl, E::name, n, n};
+        if (runner.skip(c)) continue;
+        const Container &v = prepared();
+        const std::vector<std::uint64_t> indices = makeIndices(pattern, n, n, seed);
+        runner.measure(c, [&] {
+            std::uint64_t sum = 0;
+            for (std::uint64_t index : indices) sum += E::key(v[index]);
+            doNotOptimize(sum);
+        });
+    }
+
+    const Case iterate{"vector", "iterate", impl, E::name, n, n};
+    if (!runner.skip(iterate)) {
+        const Container &v = prepared();
+        runner.measure(iterate, [&] {
+            std::uint64_t sum = 0;
+            for (const T &value : v) sum += E::key(value);
+            doNotOptimize(sum);
+        });
+    }
+
+    // 中间插入是 O(n) 的，只做固定次数
+    const std::size_t inserts = std::min<std::size_t>(n, 1000);
+    if (n <= 1000000) {
+        const std::vector<std::uint64_t> positions = makeIndices(Pattern::Random, n, inserts, seed + 1);
+        runner.measure({"vector", "insert/random", impl, E::name, n, inserts},
+                       [&] {
+                           Container v;
+                           for (std::size_t i = 0; i < n; ++i) v.push_back(E::make(i));
+                           return v;
+                       },
+                       [&](Container &v) {
+                           for (std::uint64_t pos : positions) {
+                               if constexpr (std::is_same<Container, std::vector<T>>::value) {
+                                   v.insert(v.begin() + static_cast<std::ptrdiff_t>(pos), E::make(pos));
+                               } else {
+                                   v.insert(pos, E::make(pos));
+                               }
+                           }
+                           doNotOptimize(v);
+                       });
+    }
+
+    runner.measure({"vector", "pop_back", impl, E::name, n, n},
+                   [&] {
+                       Container v;
+                       for (std::size_t i = 0; i < n; ++i) v.push_back(E::make(i));
+                       return v;
+                   },
+                   [&](Container &v) {
+                       for (std::size_t i = 0; i < n; ++i) v.pop_back();
+                       doNotOptimize(v);
+                   });
+}
+
+template <typename T>
+void runElement(Runner &runner, std::size_t n) {
+    runVector<T, Vector<T>>(runner, "Vector", n);
+    runVector<T, std::vector<T>>(runner, "std::vector", n);
+}
+
+}  // namespace
+
+void vectorSuite(Runner &runner) {
+    for (std::size_t n : runner.config().sizes) {
+        runElement<std::uint64_t>(runner, n);
+        if (n <= runner.config().largeElementLimit) runElement<Large>(runner, n);
+    }
+}
+
+}  // namespace bench
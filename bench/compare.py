@@ -0,0 +1,46 @@
+#!/usr/bin/env python3
+"""Compare two container_bench JSON files case by case.
+
+usage: compare.py BASELINE.json CANDIDATE.json [--threshold PCT]
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        return {r["id"]: r for r in json.load(f)["results"]}
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("baseline")
+    parser.add_argument("candidate")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="only print cases whose ns/op changed by more than this percentage")
+    args = parser.parse_args()
+
+    base = load(args.baseline)
+    cand = load(args.candidate)
+    regressions = 0
+    print(f"{'case':64} {'base ns/op':>12} {'new ns/op':>12} {'delta':>8}")
+    for case_id in sorted(base.keys() & cand.keys()):
+        old = base[case_id]["ns_per_op"]
+        new = cand[case_id]["ns_per_op"]
+        delta = (new - old) / old * 100 if old else 0.0
+        if abs(delta) < args.threshold:
+            continue
+        if delta > 0:
+            regressions += 1
+        print(f"{case_id:64} {old:12.2f} {new:12.2f} {delta:+7.1f}%")
+    for case_id in sorted(base.keys() - cand.keys()):
+        print(f"{case_id:64} only in baseline")
+    for case_id in sorted(cand.keys() - base.keys()):
+        print(f"{case_id:64} only in candidate")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
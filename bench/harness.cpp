@@ -0,0 +1,214 @@
+#include "harness.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench {
+
+#if defined(__linux__)
+namespace {
+
+int openCounter(std::uint64_t config, int group) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = group < 0 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+}
+
+}  // namespace
+
+PerfCounters::PerfCounters() {
+    const std::pair<std::uint64_t, const char *> events[] = {
+        {PERF_COUNT_HW_CPU_CYCLES, "cycles"},
+        {PERF_COUNT_HW_INSTRUCTIONS, "instructions"},
+        {PERF_COUNT_HW_CACHE_MISSES, "cache_misses"},
+        {PERF_COUNT_HW_BRANCH_MISSES, "branch_misses"},
+    };
+    for (const auto &event : events) {
+        const int fd = openCounter(event.first, leader);
+        if (fd < 0) {
+            // 容器、虚拟机或 perf_event_paranoid 过高时不可用，只保留已打开的计数器
+            if (leader < 0) return;
+            continue;
+        }
+        if (leader < 0) leader = fd;
+        fds.push_back(fd);
+        labels.emplace_back(event.second);
+    }
+    counts.assign(fds.size(), 0);
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds) close(fd);
+}
+
+void PerfCounters::start() {
+    if (leader < 0) return;
+    ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void PerfCounters::stop() {
+    if (leader < 0) return;
+    ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    std::vector<std::uint64_t> buffer(fds.size() + 1, 0);
+    const ssize_t bytes = read(leader, buffer.data(), buffer.size() * sizeof(std::uint64_t));
+    if (bytes < static_cast<ssize_t>(sizeof(std::uint64_t))) return;
+    for (std::size_t i = 0; i < counts.size() && i < buffer[0]; ++i) {
+        counts[i] = buffer[i + 1];
+    }
+}
+#else
+PerfCounters::PerfCounters() {}
+PerfCounters::~PerfCounters() {}
+void PerfCounters::start() {}
+void PerfCounters::stop() {}
+#endif
+
+std::string Case::id() const {
+    std::ostringstream os;
+    os << suite << '/' << workload << '/' << impl << '/' << element << '/' << size;
+    return os.str();
+}
+
+Runner::Runner(Config config) : cfg(std::move(config)) {}
+
+bool Runner::enabled(const Case &c) const {
+    if (cfg.filters.empty()) return true;
+    const std::string id = c.id();
+    for (const std::string &filter : cfg.filters) {
+        if (id.find(filter) != std::string::npos) return true;
+    }
+    return false;
+}
+
+bool Runner::skip(const Case &c) {
+    if (!enabled(c)) return true;
+    if (cfg.listOnly) {
+        listed.push_back(c.id());
+        return true;
+    }
+    return false;
+}
+
+Runner::Sample Runner::timeOnce(const std::function<void()> &body) {
+    Sample sample;
+    resetPeakLiveBytes();
+    const std::uint64_t liveBefore = liveBytes();
+    const AllocStats before = allocSnapshot();
+    perf.start();
+    const auto begin = std::chrono::steady_clock::now();
+    body();
+    clobberMemory();
+    const auto end = std::chrono::steady_clock::now();
+    perf.stop();
+    const AllocStats after = allocSnapshot();
+    sample.ns = std::chrono::duration<double, std::nano>(end - begin).count();
+    sample.allocs = {after.count - before.count, after.bytes - before.bytes};
+    const std::uint64_t peak = peakLiveBytes();
+    sample.peak = peak > liveBefore ? peak - liveBefore : 0;
+    sample.counters = perf.values();
+    return sample;
+}
+
+Result &Runner::record(const Case &c, std::vector<Sample> &samples) {
+    std::sort(samples.begin(), samples.end(), [](const Sample &a, const Sample &b) { return a.ns < b.ns; });
+    const Sample &best = samples.front();
+    const double ops = static_cast<double>(std::max<std::size_t>(1, c.ops));
+
+    Result result;
+    result.info = c;
+    result.nsPerOp = best.ns / ops;
+    result.nsPerOpMedian = samples[samples.size() / 2].ns / ops;
+    result.allocsPerOp = static_cast<double>(best.allocs.count) / ops;
+    result.bytesPerOp = static_cast<double>(best.allocs.bytes) / ops;
+    result.peakBytes = best.peak;
+    for (std::size_t i = 0; i < best.counters.size(); ++i) {
+        result.counters.emplace_back(perf.names()[i], static_cast<double>(best.counters[i]) / ops);
+    }
+    done.push_back(std::move(result));
+
+    const Result &r = done.back();
+    std::cout << std::left << std::setw(64) << c.id() << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << r.nsPerOp << " ns/op" << std::setw(10) << r.allocsPerOp << " allocs/op";
+    for (const auto &counter : r.counters) {
+        std::cout << "  " << counter.first << '=' << counter.second;
+    }
+    std::cout << std::endl;
+    return done.back();
+}
+
+void Runner::printSummary() const {
+    if (cfg.listOnly) {
+        for (const std::string &id : listed) std::cout << id << '\n';
+        return;
+    }
+    std::cout << done.size() << " benchmarks, hardware counters "
+              << (perf.available() ? "enabled" : "unavailable") << std::endl;
+}
+
+namespace {
+
+std::string escape(const std::string &text) {
+    std::string out;
+    for (char ch : text) {
+        if (ch == '"' || ch == '\\') out += '\\';
+        out += ch;
+    }
+    return out;
+}
+
+void writePairs(std::ostream &os, const std::vector<std::pair<std::string, double>> &pairs) {
+    os << '{';
+    for (std::size_t i = 0; i < pairs.size(); ++i) {
+        if (i) os << ", ";
+        os << '"' << escape(pairs[i].first) << "\": " << pairs[i].second;
+    }
+    os << '}';
+}
+
+}  // namespace
+
+bool Runner::writeJson(const std::string &path) const {
+    std::ofstream os(path);
+    if (!os) return false;
+    os << std::setprecision(6);
+    os << "{\n  \"schema\": 1,\n  \"perf_counters\": " << (perf.available() ? "true" : "false")
+       << ",\n  \"repeat\": " << cfg.repeat << ",\n  \"results\": [\n";
+    for (std::size_t i = 0; i < done.size(); ++i) {
+        const Result &r = done[i];
+        os << "    {\"id\": \"" << escape(r.info.id()) << "\", \"suite\": \"" << escape(r.info.suite)
+           << "\", \"workload\": \"" << escape(r.info.workload) << "\", \"impl\": \"" << escape(r.info.impl)
+           << "\", \"element\": \"" << escape(r.info.element) << "\", \"size\": " << r.info.size
+           << ", \"ops\": " << r.info.ops << ", \"ns_per_op\": " << r.nsPerOp
+           << ", \"ns_per_op_median\": " << r.nsPerOpMedian << ", \"allocs_per_op\": " << r.allocsPerOp
+           << ", \"bytes_per_op\": " << r.bytesPerOp << ", \"peak_bytes\": " << r.peakBytes
+           << ", \"counters\": ";
+        writePairs(os, r.counters);
+        os << ", \"metrics\": ";
+        writePairs(os, r.metrics);
+        os << '}' << (i + 1 < done.size() ? ",\n" : "\n");
+    }
+    os << "  ]\n}\n";
+    return static_cast<bool>(os);
+}
+
+}  // namespace bench
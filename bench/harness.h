@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// 自包含的基准测试框架：计时、分配计数（alloc_counter.cpp 替换了全局 operator new）、
+// Linux 上通过 perf_event_open 读取硬件计数器，结果输出为可在两次运行之间比较的 JSON。
+namespace bench {
+
+struct AllocStats {
+    std::uint64_t count;
+    std::uint64_t bytes;
+};
+
+AllocStats allocSnapshot();
+std::uint64_t liveBytes();
+std::uint64_t peakLiveBytes();
+void resetPeakLiveBytes();
+
+template <typename T>
+inline void doNotOptimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    volatile const T *sink = &value;
+    (void)sink;
+#endif
+}
+
+inline void clobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    bool available() const { return leader >= 0; }
+    void start();
+    void stop();
+    // 与 names() 一一对应，stop() 之后有效
+    const std::vector<std::uint64_t> &values() const { return counts; }
+    const std::vector<std::string> &names() const { return labels; }
+
+private:
+    int leader = -1;
+    std::vector<int> fds;
+    std::vector<std::string> labels;
+    std::vector<std::uint64_t> counts;
+};
+
+struct Case {
+    std::string suite;     // 容器族，如 "vector"
+    std::string workload;  // 如 "push_back/sequential"
+    std::string impl;      // 被测实现，如 "Vector" 或 "std::vector"
+    std::string element;   // 元素类型，如 "int64" 或 "large256"
+    std::size_t size;      // 数据规模
+    std::size_t ops;       // 每次重复执行的操作数，用于折算 ns/op
+
+    std::string id() const;
+};
+
+struct Result {
+    Case info;
+    double nsPerOp = 0;
+    double nsPerOpMedian = 0;
+    double allocsPerOp = 0;
+    double bytesPerOp = 0;
+    std::uint64_t peakBytes = 0;
+    std::vector<std::pair<std::string, double>> counters;  // 每操作的硬件计数
+    std::vector<std::pair<std::string, double>> metrics;   // 负载相关的附加指标，如命中率
+};
+
+struct Config {
+    std::vector<std::size_t> sizes = {1000, 10000, 100000, 1000000};
+    std::vector<unsigned> threads = {1, 2, 4, 8, 16, 32};
+    std::size_t largeElementLimit = 10000000;  // 大元素负载的规模上限，避免 100M x 256B
+    unsigned repeat = 3;
+    std::vector<std::string> filters;
+    std::string jsonPath;
+    bool listOnly = false;
+    std::uint64_t seed = 42;
+};
+
+class Runner {
+public:
+    explicit Runner(Config cfg);
+
+    const Config &config() const { return cfg; }
+    bool enabled(const Case &c) const;
+
+    // 被过滤掉或只列出用例时返回 true；调用方据此跳过昂贵的共享数据准备
+    bool skip(const Case &c);
+
+    // setup 的返回值作为状态传给 body；只有 body 计时，每次重复都重新 setup
+    template <typename Setup, typename Body>
+    Result &measure(const Case &c, Setup setup, Body body) {
+        static Result skipped;
+        if (skip(c)) return skipped;
+        std::vector<Sample> samples;
+        for (unsigned rep = 0; rep < std::max(1u, cfg.repeat); ++rep) {
+            auto state = setup();
+            clobberMemory();
+            samples.push_back(timeOnce([&] { body(state); }));
+        }
+        return record(c, samples);
+    }
+
+    template <typename Body>
+    Result &measure(const Case &c, Body body) {
+        return measure(c, [] { return 0; }, [&](int &) { body(); });
+    }
+
+    const std::vector<Result> &results() const { return done; }
+    const std::vector<std::string> &listedCases() const { return listed; }
+
+    void printSummary() const;
+    bool writeJson(const std::string &path) const;
+
+private:
+    struct Sample {
+        double ns;
+        AllocStats allocs;
+        std::uint64_t peak;
+        std::vector<std::uint64_t> counters;
+    };
+
+    Sample timeOnce(const std::function<void()> &body);
+    Result &record(const Case &c, std::vector<Sample> &samples);
+
+    Config cfg;
+    PerfCounters perf;
+    std::vector<Result> done;
+    std::vector<std::string> listed;
+};
+
+using Suite = void (*)(Runner &);
+
+}  // namespace bench
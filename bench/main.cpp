@@ -0,0 +1,107 @@
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "harness.h"
+
+namespace bench {
+
+void vectorSuite(Runner &runner);
+void listSuite(Runner &runner);
+void dequeSuite(Runner &runner);
+void hashTableSuite(Runner &runner);
+void rbtreeSuite(Runner &runner);
+void adaptorSuite(Runner &runner);
+void priorityQueueSuite(Runner &runner);
+void cacheSuite(Runner &runner);
+void statsSuite(Runner &runner);
+void memorySuite(Runner &runner);
+
+}  // namespace bench
+
+namespace {
+
+void usage() {
+    std::cout << "usage: container_bench [options]\n"
+                 "  --filter TEXT      only run cases whose id contains TEXT (repeatable)\n"
+                 "                     ids look like suite/workload/impl/element/size\n"
+                 "  --sizes A,B,...    data sizes (default 1000,10000,100000,1000000)\n"
+                 "  --max-size N       use powers of ten from 1000 up to N, e.g. 100000000\n"
+                 "  --threads A,B,...  thread counts for the sharded cache (default 1,2,4,8,16,32)\n"
+                 "  --large-limit N    largest size used with 256-byte elements (default 10000000)\n"
+                 "  --repeat N         repetitions per case, the fastest is reported (default 3)\n"
+                 "  --seed N           workload seed (default 42)\n"
+                 "  --json PATH        write results as JSON, compare runs with bench/compare.py\n"
+                 "  --list             list case ids without running them\n";
+}
+
+template <typename T>
+std::vector<T> parseList(const std::string &text) {
+    std::vector<T> out;
+    std::istringstream is(text);
+    std::string item;
+    while (std::getline(is, item, ',')) {
+        if (!item.empty()) out.push_back(static_cast<T>(std::stoull(item)));
+    }
+    return out;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    bench::Config config;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "missing value for " << arg << '\n';
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        if (arg == "--filter") {
+            config.filters.push_back(value());
+        } else if (arg == "--sizes") {
+            config.sizes = parseList<std::size_t>(value());
+        } else if (arg == "--max-size") {
+            const std::size_t limit = std::stoull(value());
+            config.sizes.clear();
+            for (std::size_t n = 1000; n <= limit; n *= 10) config.sizes.push_back(n);
+        } else if (arg == "--threads") {
+            config.threads = parseList<unsigned>(value());
+        } else if (arg == "--large-limit") {
+            config.largeElementLimit = std::stoull(value());
+        } else if (arg == "--repeat") {
+            config.repeat = static_cast<unsigned>(std::stoul(value()));
+        } else if (arg == "--seed") {
+            config.seed = std::stoull(value());
+        } else if (arg == "--json") {
+            config.jsonPath = value();
+        } else if (arg == "--list") {
+            config.listOnly = true;
+        } else if (arg == "--help" || arg == "-h") {
+            usage();
+            return 0;
+        } else {
+            std::cerr << "unknown option " << arg << '\n';
+            usage();
+            return 2;
+        }
+    }
+
+    bench::Runner runner(config);
+    const bench::Suite suites[] = {
+        bench::vectorSuite,   bench::listSuite,    bench::dequeSuite,         bench::hashTableSuite,
+        bench::rbtreeSuite,   bench::adaptorSuite, bench::priorityQueueSuite, bench::cacheSuite,
+        bench::statsSuite,    bench::memorySuite,
+    };
+    for (bench::Suite suite : suites) suite(runner);
+    runner.printSummary();
+
+    if (!config.jsonPath.empty() && !runner.writeJson(config.jsonPath)) {
+        std::cerr << "failed to write " << config.jsonPath << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+# 检查 NullStats 的零开销：把带统计钩子的容器源码复制一份、删掉所有钩子调用，
+# 再用同一编译器和同样的优化级别把 hot_loops.cpp 分别针对两份源码编译成汇编并逐行比较。
+#
+#   cmake -DCXX=<compiler> -DSOURCE_DIR=<repo> -DWORK_DIR=<dir> [-DOPT_LEVELS=-O2,-O3] -P check_asm.cmake
+
+cmake_minimum_required(VERSION 3.16)
+
+foreach(var CXX SOURCE_DIR WORK_DIR)
+  if(NOT DEFINED ${var})
+    message(FATAL_ERROR "check_asm.cmake: ${var} is required")
+  endif()
+endforeach()
+if(NOT DEFINED OPT_LEVELS)
+  set(OPT_LEVELS -O2)
+endif()
+string(REPLACE "," ";" OPT_LEVELS "${OPT_LEVELS}")
+
+set(containers
+  day_01/vector.cpp
+  day_03/deque.cpp
+  day_04/hash_table.cpp
+  day_05/rbtree.c++
+  day_14/heap.cpp)
+set(headers
+  common/container_stats.h
+  common/memory_resources.h)
+
+file(REMOVE_RECURSE "${WORK_DIR}")
+file(MAKE_DIRECTORY "${WORK_DIR}/stripped/common")
+
+foreach(header IN LISTS headers)
+  configure_file("${SOURCE_DIR}/${header}" "${WORK_DIR}/stripped/${header}" COPYONLY)
+endforeach()
+
+# 钩子都是单行语句：Stats::onXxx(...); 以及 typename Stats::Stopwatch name;
+# 删除后若仍残留钩子（例如将来写成多行），直接报错，避免比较失去意义
+foreach(container IN LISTS containers)
+  file(READ "${SOURCE_DIR}/${container}" content)
+  string(REGEX REPLACE "\n[ \t]*Stats::on[A-Za-z]+\\([^\n]*\\);[ \t]*" "\n" stripped "${content}")
+  string(REGEX REPLACE "\n[ \t]*typename Stats::Stopwatch [A-Za-z_]+;[ \t]*" "\n" stripped "${stripped}")
+  if(stripped STREQUAL content)
+    message(FATAL_ERROR "no stats hooks found in ${container}")
+  endif()
+  if(stripped MATCHES "Stats::on[A-Za-z]+\\(|Stats::Stopwatch")
+    message(FATAL_ERROR "stats hooks left in ${container} after stripping")
+  endif()
+  file(WRITE "${WORK_DIR}/stripped/${container}" "${stripped}")
+endforeach()
+
+function(compile_asm root opt output)
+  set(includes)
+  foreach(container IN LISTS containers)
+    get_filename_component(dir "${container}" DIRECTORY)
+    list(APPEND includes "-I${root}/${dir}")
+  endforeach()
+  execute_process(
+    COMMAND "${CXX}" -std=c++17 ${opt} -S -o "${output}" ${includes} "${SOURCE_DIR}/bench/null_stats/hot_loops.cpp"
+    RESULT_VARIABLE result
+    ERROR_VARIABLE errors)
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "compiling hot_loops.cpp against ${root} failed:\n${errors}")
+  endif()
+  # 去掉与代码无关、可能随路径或编译器版本变化的行。GCC 的 .LFB / .LFE / .LLSDA 等标签按翻译单元内
+  # 出现过的函数全局编号，空钩子本身也占号，所以只比较标签前缀、不比较编号；.L<数字> 的跳转标签保持原样
+  file(READ "${output}" asm)
+  string(REGEX REPLACE "(^|\n)[ \t]*\\.(file|ident)[^\n]*" "" asm "${asm}")
+  string(REGEX REPLACE "\\.(L[A-Z]+)[0-9]+" ".\\1" asm "${asm}")
+  file(WRITE "${output}.normalized" "${asm}")
+endfunction()
+
+foreach(opt IN LISTS OPT_LEVELS)
+  set(instrumented "${WORK_DIR}/instrumented${opt}.s")
+  set(stripped "${WORK_DIR}/stripped${opt}.s")
+  compile_asm("${SOURCE_DIR}" "${opt}" "${instrumented}")
+  compile_asm("${WORK_DIR}/stripped" "${opt}" "${stripped}")
+  execute_process(
+    COMMAND "${CMAKE_COMMAND}" -E compare_files "${instrumented}.normalized" "${stripped}.normalized"
+    RESULT_VARIABLE differs)
+  if(differs)
+    message(FATAL_ERROR "NullStats hot loops differ from the hook-free build at ${opt}; "
+                        "compare ${instrumented}.normalized with ${stripped}.normalized")
+  endif()
+  file(READ "${instrumented}.normalized" asm)
+  string(REGEX MATCHALL "\n" newlines "${asm}")
+  list(LENGTH newlines count)
+  message(STATUS "${opt}: ${count} lines of assembly identical with and without stats hooks")
+endforeach()
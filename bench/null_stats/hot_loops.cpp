@@ -0,0 +1,68 @@
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "deque.cpp"
+#include "hash_table.cpp"
+#include "heap.cpp"
+#include "rbtree.c++"
+#include "vector.cpp"
+
+// 同一份热循环分别针对带统计钩子的容器源码和去掉钩子的副本编译（见 check_asm.cmake），
+// 以 NullStats 实例化时两份汇编必须逐行相同。函数有外部链接，避免被整体优化掉
+
+using Entry = std::pair<const std::uint64_t, std::uint64_t>;
+using HotVector = Vector<std::uint64_t, std::allocator<std::uint64_t>, NullStats>;
+using HotDeque = Deque<std::uint64_t, std::allocator<std::uint64_t>, NullStats>;
+using HotHashTable = HashTable<std::uint64_t, std::uint64_t, std::hash<std::uint64_t>, std::allocator<Entry>, NullStats>;
+using HotTree = RedBlackTree<std::uint64_t, std::uint64_t, std::allocator<Entry>, NullStats>;
+using HotQueue = MyPriorityQueue<std::uint64_t, std::vector<std::uint64_t>, std::less<std::uint64_t>, NullStats>;
+
+std::uint64_t vectorPushBack(HotVector &v, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) v.push_back(i);
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < v.getSize(); ++i) sum += v[i];
+    return sum;
+}
+
+std::uint64_t dequePushPop(HotDeque &d, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) d.push_back(i);
+    std::uint64_t sum = 0;
+    while (!d.empty()) {
+        sum += d[0];
+        d.pop_front();
+    }
+    return sum;
+}
+
+std::uint64_t hashTableInsertFind(HotHashTable &map, const std::uint64_t *keys, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) map.insert(keys[i], i);
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (std::uint64_t *value = map.find(keys[i])) sum += *value;
+    }
+    return sum;
+}
+
+std::uint64_t treeInsertFind(HotTree &tree, const std::uint64_t *keys, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) tree.insert(keys[i], i);
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (std::uint64_t *value = tree.at(keys[i])) sum += *value;
+    }
+    for (std::size_t i = 0; i < n; i += 2) tree.remove(keys[i]);
+    return sum;
+}
+
+std::uint64_t priorityQueuePushPop(HotQueue &q, const std::uint64_t *keys, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) q.push(keys[i]);
+    std::uint64_t sum = 0;
+    while (!q.empty()) {
+        sum += q.top();
+        q.pop();
+    }
+    return sum;
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+// 标准负载：顺序、均匀随机与 Zipfian 访问序列，以及小（8 字节）和大（256 字节）两种元素类型
+namespace bench {
+
+class Rng {
+public:
+    explicit Rng(std::uint64_t seed) : state(seed ? seed : 0x9e3779b97f4a7c15ULL) {}
+
+    std::uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    // [0, bound) 上的均匀分布（Lemire 乘法映射）
+    std::uint64_t below(std::uint64_t bound) {
+        return static_cast<std::uint64_t>((static_cast<unsigned __int128>(next()) * bound) >> 64);
+    }
+
+    double unit() { return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0); }
+
+private:
+    std::uint64_t state;
+};
+
+inline std::uint64_t scramble(std::uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+// YCSB 的 Zipfian 生成器（Gray 等人的近似算法），排名经过打散，热点不会聚集在小下标上
+class ZipfianGenerator {
+public:
+    ZipfianGenerator(std::uint64_t n, double theta = 0.99) : items(n), theta(theta) {
+        if (n < 3) return;
+        zetan = zeta(n, theta);
+        const double zeta2 = zeta(2, theta);
+        alpha = 1.0 / (1.0 - theta);
+        eta = (1.0 - std::pow(2.0 / static_cast<double>(n), 1.0 - theta)) / (1.0 - zeta2 / zetan);
+    }
+
+    std::uint64_t rank(Rng &rng) const {
+        if (items < 3) return rng.below(items);
+        const double u = rng.unit();
+        const double uz = u * zetan;
+        if (uz < 1.0) return 0;
+        if (uz < 1.0 + std::pow(0.5, theta)) return 1;
+        const auto r = static_cast<std::uint64_t>(static_cast<double>(items) * std::pow(eta * u - eta + 1.0, alpha));
+        return r < items ? r : items - 1;
+    }
+
+    std::uint64_t next(Rng &rng) const { return scramble(rank(rng)) % items; }
+
+private:
+    static double zeta(std::uint64_t n, double theta) {
+        double sum = 0;
+        for (std::uint64_t i = 1; i <= n; ++i) sum += 1.0 / std::pow(static_cast<double>(i), theta);
+        return sum;
+    }
+
+    std::uint64_t items;
+    double theta;
+    double zetan = 0;
+    double alpha = 0;
+    double eta = 0;
+};
+
+enum class Pattern { Sequential, Random, Zipfian };
+
+inline const char *patternName(Pattern pattern) {
+    switch (pattern) {
+    case Pattern::Sequential: return "sequential";
+    case Pattern::Random: return "random";
+    default: return "zipfian";
+    }
+}
+
+constexpr Pattern kPatterns[] = {Pattern::Sequential, Pattern::Random, Pattern::Zipfian};
+
+// 生成 count 个 [0, n) 上的下标
+inline std::vector<std::uint64_t> makeIndices(Pattern pattern, std::uint64_t n, std::size_t count, std::uint64_t seed) {
+    std::vector<std::uint64_t> out(count);
+    Rng rng(seed);
+    switch (pattern) {
+    case Pattern::Sequential:
+        for (std::size_t i = 0; i < count; ++i) out[i] = i % n;
+        break;
+    case Pattern::Random:
+        for (std::size_t i = 0; i < count; ++i) out[i] = rng.below(n);
+        break;
+    case Pattern::Zipfian: {
+        ZipfianGenerator zipf(n);
+        for (std::size_t i = 0; i < count; ++i) out[i] = zipf.next(rng);
+        break;
+    }
+    }
+    return out;
+}
+
+struct Large {
+    std::uint64_t key;
+    unsigned char payload[248];
+
+    Large() : key(0) { std::memset(payload, 0, sizeof(payload)); }
+    explicit Large(std::uint64_t k) : key(k) { std::memset(payload, static_cast<int>(k & 0xff), sizeof(payload)); }
+
+    bool operator==(const Large &other) const { return key == other.key; }
+    bool operator!=(const Large &other) const { return key != other.key; }
+    bool operator<(const Large &other) const { return key < other.key; }
+    bool operator>(const Large &other) const { return key > other.key; }
+};
+
+struct LargeHash {
+    std::size_t operator()(const Large &value) const { return std::hash<std::uint64_t>()(value.key); }
+};
+
+template <typename T>
+struct Element;
+
+template <>
+struct Element<std::uint64_t> {
+    static constexpr const char *name = "int64";
+    using hash = std::hash<std::uint64_t>;
+    static std::uint64_t make(std::uint64_t key) { return key; }
+    static std::uint64_t key(std::uint64_t value) { return value; }
+};
+
+template <>
+struct Element<Large> {
+    static constexpr const char *name = "large256";
+    using hash = LargeHash;
+    static Large make(std::uint64_t key) { return Large(key); }
+    static std::uint64_t key(const Large &value) { return value.key; }
+};
+
+}  // namespace bench
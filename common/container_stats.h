@@ -0,0 +1,192 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+// 容器内部埋点。容器把统计策略作为最后一个模板参数并私有继承它：
+//   NullStats      所有钩子都是空的内联函数，空基类优化后不占空间，热路径与未埋点时完全相同；
+//   ContainerStats 记录扩容 / rehash 次数与停顿、桶链长度、旋转次数、树深度、堆的上浮下沉距离。
+// 未显式指定时使用 DefaultStats，定义 ROOKIE_CONTAINER_STATS 宏即可全局打开。
+
+// 以 2 为底的对数分桶直方图：第 i 个桶统计 [2^(i-1), 2^i) 的样本，第 0 个桶只统计 0
+class Histogram {
+public:
+    static constexpr std::size_t kBuckets = 65;
+
+    void record(std::uint64_t value) noexcept {
+        ++buckets[bucketOf(value)];
+        ++samples;
+        total += value;
+        if (value > largest) largest = value;
+    }
+
+    std::uint64_t count() const noexcept { return samples; }
+    std::uint64_t sum() const noexcept { return total; }
+    std::uint64_t max() const noexcept { return largest; }
+    double mean() const noexcept { return samples ? static_cast<double>(total) / samples : 0.0; }
+    std::uint64_t bucket(std::size_t i) const { return buckets.at(i); }
+
+    // 返回第 p 分位样本所在桶的上界（不超过实际最大值），p 取 [0, 1]
+    std::uint64_t percentile(double p) const noexcept {
+        if (samples == 0) return 0;
+        const auto rank = static_cast<std::uint64_t>(p * static_cast<double>(samples - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                const std::uint64_t upper = i == 0 ? 0 : i >= 64 ? largest : (std::uint64_t(1) << i) - 1;
+                return upper < largest ? upper : largest;
+            }
+        }
+        return largest;
+    }
+
+    void reset() noexcept { *this = Histogram(); }
+
+private:
+    static std::size_t bucketOf(std::uint64_t value) noexcept {
+        if (value == 0) return 0;
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(64 - __builtin_clzll(value));
+#else
+        std::size_t width = 0;
+        while (value) { value >>= 1; ++width; }
+        return width;
+#endif
+    }
+
+    std::array<std::uint64_t, kBuckets> buckets{};
+    std::uint64_t samples = 0;
+    std::uint64_t total = 0;
+    std::uint64_t largest = 0;
+};
+
+// stats() 返回的快照。各容器只填写与自己相关的字段：
+//   Vector / Deque / HashTable 的 grows 分别是 reserve、ensure_capacity、rehash 的次数；
+//   chainLength 只来自 HashTable，rotations / depth 只来自 RedBlackTree，siftDistance 只来自 MyPriorityQueue。
+struct StatsSnapshot {
+    std::uint64_t operations = 0;     // 插入、删除、查找等公开操作的次数
+    std::uint64_t grows = 0;          // 扩容次数
+    std::uint64_t elementsMoved = 0;  // 扩容时搬移的元素总数
+    std::uint64_t bytesAllocated = 0; // 扩容时新申请的字节总数
+    std::uint64_t rotations = 0;      // 红黑树旋转次数
+    Histogram growPauseNanos;         // 每次扩容 / rehash 的停顿（纳秒）
+    Histogram chainLength;            // 每次查找、插入、删除时目标桶的链长
+    Histogram depth;                  // 红黑树查找 / 插入经过的层数
+    Histogram siftDistance;           // 堆每次上浮 / 下沉移动的层数
+};
+
+inline std::ostream &operator<<(std::ostream &os, const Histogram &h) {
+    return os << "{count " << h.count() << ", mean " << h.mean() << ", p50 " << h.percentile(0.5)
+              << ", p99 " << h.percentile(0.99) << ", max " << h.max() << "}";
+}
+
+inline std::ostream &operator<<(std::ostream &os, const StatsSnapshot &s) {
+    os << "operations " << s.operations << ", grows " << s.grows << ", moved " << s.elementsMoved
+       << ", allocated " << s.bytesAllocated << "B, rotations " << s.rotations;
+    if (s.growPauseNanos.count()) os << "\n  grow pause ns " << s.growPauseNanos;
+    if (s.chainLength.count()) os << "\n  chain length  " << s.chainLength;
+    if (s.depth.count()) os << "\n  depth         " << s.depth;
+    if (s.siftDistance.count()) os << "\n  sift distance " << s.siftDistance;
+    return os;
+}
+
+using StatsDumpHook = std::function<void(const StatsSnapshot &)>;
+
+struct NullStats {
+    static constexpr bool enabled = false;
+
+    struct Stopwatch {
+        constexpr std::uint64_t elapsedNanos() const noexcept { return 0; }
+    };
+
+    void onOperation() noexcept {}
+    void onGrow(std::size_t, std::size_t, std::uint64_t) noexcept {}
+    void onChain(std::size_t) noexcept {}
+    void onRotate() noexcept {}
+    void onDepth(std::size_t) noexcept {}
+    void onSift(std::size_t) noexcept {}
+
+    StatsSnapshot snapshot() const { return StatsSnapshot(); }
+    void setDumpHook(StatsDumpHook, std::uint64_t) noexcept {}
+    void resetStats() noexcept {}
+};
+
+class ContainerStats {
+public:
+    static constexpr bool enabled = true;
+
+    // 统计数据与 dump hook 属于容器对象本身：拷贝 / 移动构造出的容器从零开始统计，
+    // 赋值与交换只转移元素、各自保留原有的统计。五个容器的拷贝与移动（包括默认生成的）都经由这里
+    ContainerStats() = default;
+    ContainerStats(const ContainerStats &) noexcept : ContainerStats() {}
+    ContainerStats &operator=(const ContainerStats &) noexcept { return *this; }
+
+    class Stopwatch {
+    public:
+        Stopwatch() : start(std::chrono::steady_clock::now()) {}
+        std::uint64_t elapsedNanos() const {
+            return static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        }
+
+    private:
+        std::chrono::steady_clock::time_point start;
+    };
+
+    void onOperation() {
+        ++current.operations;
+        if (--untilDump == 0) {
+            untilDump = dumpEvery;
+            dumpHook(current);
+        }
+    }
+
+    void onGrow(std::size_t moved, std::size_t bytes, std::uint64_t nanos) noexcept {
+        ++current.grows;
+        current.elementsMoved += moved;
+        current.bytesAllocated += bytes;
+        current.growPauseNanos.record(nanos);
+    }
+
+    void onChain(std::size_t length) noexcept { current.chainLength.record(length); }
+    void onRotate() noexcept { ++current.rotations; }
+    void onDepth(std::size_t levels) noexcept { current.depth.record(levels); }
+    void onSift(std::size_t levels) noexcept { current.siftDistance.record(levels); }
+
+    StatsSnapshot snapshot() const { return current; }
+
+    // 每 everyOps 次操作调用一次 hook，everyOps 为 0 或 hook 为空时关闭
+    void setDumpHook(StatsDumpHook hook, std::uint64_t everyOps) {
+        if (!hook || everyOps == 0) {
+            dumpHook = nullptr;
+            dumpEvery = untilDump = std::numeric_limits<std::uint64_t>::max();
+            return;
+        }
+        dumpHook = std::move(hook);
+        dumpEvery = untilDump = everyOps;
+    }
+
+    void resetStats() noexcept {
+        current = StatsSnapshot();
+        untilDump = dumpEvery;
+    }
+
+private:
+    StatsSnapshot current;
+    StatsDumpHook dumpHook;
+    std::uint64_t dumpEvery = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t untilDump = std::numeric_limits<std::uint64_t>::max();
+};
+
+#ifdef ROOKIE_CONTAINER_STATS
+using DefaultStats = ContainerStats;
+#else
+using DefaultStats = NullStats;
+#endif
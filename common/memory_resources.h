@@ -0,0 +1,276 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+// 分配器支持：
+//   AllocatorHolder  容器保存分配器的基类，无状态分配器经空基类优化后不占空间；
+//   MonotonicArena   单调递增的 std::pmr 资源，deallocate 为空操作，reset() 一次性回收一个请求的全部内存；
+//   SizeClassPool    按尺寸分级的 std::pmr 节点池，每级一条空闲链表，适合反复增删节点的容器。
+
+template <typename Alloc, bool = std::is_empty<Alloc>::value && !std::is_final<Alloc>::value>
+class AllocatorHolder : private Alloc {
+public:
+    AllocatorHolder() = default;
+    explicit AllocatorHolder(const Alloc &alloc) : Alloc(alloc) {}
+
+    Alloc &allocator() noexcept { return *this; }
+    const Alloc &allocator() const noexcept { return *this; }
+};
+
+template <typename Alloc>
+class AllocatorHolder<Alloc, false> {
+public:
+    AllocatorHolder() = default;
+    explicit AllocatorHolder(const Alloc &alloc) : alloc(alloc) {}
+
+    Alloc &allocator() noexcept { return alloc; }
+    const Alloc &allocator() const noexcept { return alloc; }
+
+private:
+    Alloc alloc;
+};
+
+// 从上游按块申请内存并顺序切分。典型用法是每个请求一个作用域：
+//   arena.reset();  // 上一个请求的容器析构之后调用，保留最大的一块供本次复用
+class MonotonicArena : public std::pmr::memory_resource {
+public:
+    explicit MonotonicArena(std::size_t initialBytes = 4096,
+                            std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+        : upstreamResource(upstream), nextBlock(std::max<std::size_t>(initialBytes, 64)) {}
+
+    // 首块使用调用方提供的缓冲区（例如栈上数组），用完后才向上游申请
+    MonotonicArena(void *buffer, std::size_t bytes,
+                   std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+        : upstreamResource(upstream),
+          initialBuffer(static_cast<unsigned char *>(buffer)),
+          initialBytes(bytes),
+          cursor(initialBuffer),
+          limit(initialBuffer + bytes),
+          nextBlock(std::max<std::size_t>(bytes * 2, 64)) {}
+
+    MonotonicArena(const MonotonicArena &) = delete;
+    MonotonicArena &operator=(const MonotonicArena &) = delete;
+
+    ~MonotonicArena() override { release(); }
+
+    // 归还所有上游块，回到构造时的状态
+    void release() noexcept {
+        while (blocks) {
+            Block *prev = blocks->prev;
+            upstreamResource->deallocate(blocks, blocks->bytes, alignof(std::max_align_t));
+            blocks = prev;
+        }
+        reserved = 0;
+        rewind();
+    }
+
+    // 只保留最近申请（也是最大）的一块并从头开始使用；请求规模稳定后不再访问上游
+    void reset() noexcept {
+        if (blocks) {
+            Block *keep = blocks;
+            blocks = keep->prev;
+            release();
+            keep->prev = nullptr;
+            blocks = keep;
+            reserved = keep->bytes;
+            cursor = reinterpret_cast<unsigned char *>(keep) + sizeof(Block);
+            limit = reinterpret_cast<unsigned char *>(keep) + keep->bytes;
+            used = 0;
+        } else {
+            rewind();
+        }
+    }
+
+    std::size_t bytesUsed() const noexcept { return used; }
+    std::size_t bytesReserved() const noexcept { return reserved; }
+    std::pmr::memory_resource *upstream() const noexcept { return upstreamResource; }
+
+private:
+    // 上游块的头部，其余空间用于切分；头部大小保证负载区按 max_align_t 对齐
+    struct alignas(std::max_align_t) Block {
+        Block *prev;
+        std::size_t bytes;
+    };
+
+    static constexpr std::size_t kMaxGrowth = std::size_t(64) << 20;
+
+    void rewind() noexcept {
+        cursor = initialBuffer;
+        limit = initialBuffer ? initialBuffer + initialBytes : nullptr;
+        used = 0;
+    }
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        bytes = std::max<std::size_t>(bytes, 1);
+        void *p = cursor;
+        std::size_t space = static_cast<std::size_t>(limit - cursor);
+        if (!cursor || !std::align(alignment, bytes, p, space)) {
+            grow(bytes, alignment);
+            p = cursor;
+            space = static_cast<std::size_t>(limit - cursor);
+            std::align(alignment, bytes, p, space);
+        }
+        cursor = static_cast<unsigned char *>(p) + bytes;
+        used += bytes;
+        return p;
+    }
+
+    void do_deallocate(void *, std::size_t, std::size_t) noexcept override {}
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    void grow(std::size_t bytes, std::size_t alignment) {
+        const std::size_t need = sizeof(Block) + bytes + (alignment > alignof(std::max_align_t) ? alignment : 0);
+        const std::size_t blockBytes = std::max(nextBlock, need);
+        void *memory = upstreamResource->allocate(blockBytes, alignof(std::max_align_t));
+        blocks = ::new (memory) Block{blocks, blockBytes};
+        reserved += blockBytes;
+        cursor = static_cast<unsigned char *>(memory) + sizeof(Block);
+        limit = static_cast<unsigned char *>(memory) + blockBytes;
+        nextBlock = std::min(blockBytes * 2, std::max(kMaxGrowth, blockBytes));
+    }
+
+    std::pmr::memory_resource *upstreamResource;
+    unsigned char *initialBuffer = nullptr;
+    std::size_t initialBytes = 0;
+    unsigned char *cursor = nullptr;
+    unsigned char *limit = nullptr;
+    Block *blocks = nullptr;
+    std::size_t nextBlock;
+    std::size_t used = 0;
+    std::size_t reserved = 0;
+};
+
+// 尺寸分级节点池（非线程安全）。级别按本仓库容器的节点大小选取：
+// HashTable<int64, int64> 的 std::list 节点 32 字节、RedBlackTree<int64, int64> 的节点 48 字节、
+// UnrolledList<int64> 的块 88 字节；List 自带节点池，只向资源申请整块。
+// 超过 512 字节或对齐要求超过 max_align_t 的请求直接转给上游。
+class SizeClassPool : public std::pmr::memory_resource {
+public:
+    static constexpr std::size_t kMaxBlockSize = 512;
+
+    explicit SizeClassPool(std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+        : upstreamResource(upstream) {
+        for (std::size_t i = 0; i < kClassCount; ++i) {
+            classes[i].blockSize = kClassSizes[i];
+            classes[i].nextCount = std::max<std::size_t>(16, kFirstChunkBytes / kClassSizes[i]);
+        }
+    }
+
+    SizeClassPool(const SizeClassPool &) = delete;
+    SizeClassPool &operator=(const SizeClassPool &) = delete;
+
+    ~SizeClassPool() override { release(); }
+
+    // 归还所有块；池中分配出去的内存随之失效
+    void release() noexcept {
+        while (chunks) {
+            Chunk *next = chunks->next;
+            upstreamResource->deallocate(chunks, chunks->bytes, alignof(std::max_align_t));
+            chunks = next;
+        }
+        for (std::size_t i = 0; i < kClassCount; ++i) {
+            classes[i].freeList = nullptr;
+            classes[i].cursor = classes[i].limit = nullptr;
+            classes[i].nextCount = std::max<std::size_t>(16, kFirstChunkBytes / kClassSizes[i]);
+        }
+        reserved = 0;
+    }
+
+    std::size_t bytesReserved() const noexcept { return reserved; }
+    std::pmr::memory_resource *upstream() const noexcept { return upstreamResource; }
+
+private:
+    static constexpr std::size_t kClassSizes[] = {8,   16,  24,  32,  40,  48,  56,  64,  80,  96,
+                                                  112, 128, 160, 192, 224, 256, 320, 384, 448, 512};
+    static constexpr std::size_t kClassCount = sizeof(kClassSizes) / sizeof(kClassSizes[0]);
+    static constexpr std::size_t kNoClass = kClassCount;
+    static constexpr std::size_t kFirstChunkBytes = 1024;
+    static constexpr std::size_t kMaxChunkBytes = 64 * 1024;
+
+    // 以 8 字节为粒度查表得到级别
+    static constexpr std::array<unsigned char, kMaxBlockSize / 8> kClassOf = [] {
+        std::array<unsigned char, kMaxBlockSize / 8> table{};
+        std::size_t cls = 0;
+        for (std::size_t i = 0; i < table.size(); ++i) {
+            while (kClassSizes[cls] < (i + 1) * 8) ++cls;
+            table[i] = static_cast<unsigned char>(cls);
+        }
+        return table;
+    }();
+
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    struct alignas(std::max_align_t) Chunk {
+        Chunk *next;
+        std::size_t bytes;
+    };
+
+    struct SizeClass {
+        FreeBlock *freeList = nullptr;
+        unsigned char *cursor = nullptr;
+        unsigned char *limit = nullptr;
+        std::size_t blockSize = 0;
+        std::size_t nextCount = 0;
+    };
+
+    // 把尺寸向上取整到对齐的倍数后查级别；各级尺寸对不超过 max_align_t 的对齐都能整除取整后的尺寸
+    static std::size_t classFor(std::size_t bytes, std::size_t alignment) noexcept {
+        if (alignment > alignof(std::max_align_t)) return kNoClass;
+        const std::size_t size = (std::max<std::size_t>(bytes, 1) + alignment - 1) & ~(alignment - 1);
+        if (size > kMaxBlockSize) return kNoClass;
+        return kClassOf[(size - 1) / 8];
+    }
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        const std::size_t cls = classFor(bytes, alignment);
+        if (cls == kNoClass) return upstreamResource->allocate(bytes, alignment);
+        SizeClass &sc = classes[cls];
+        if (sc.freeList) {
+            FreeBlock *block = sc.freeList;
+            sc.freeList = block->next;
+            return block;
+        }
+        if (sc.cursor == sc.limit) refill(sc);
+        void *p = sc.cursor;
+        sc.cursor += sc.blockSize;
+        return p;
+    }
+
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) noexcept override {
+        const std::size_t cls = classFor(bytes, alignment);
+        if (cls == kNoClass) {
+            upstreamResource->deallocate(p, bytes, alignment);
+            return;
+        }
+        FreeBlock *block = static_cast<FreeBlock *>(p);
+        block->next = classes[cls].freeList;
+        classes[cls].freeList = block;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    // 每级的块按几何级数增长，单块不超过 64 KiB
+    void refill(SizeClass &sc) {
+        const std::size_t bytes = sizeof(Chunk) + sc.blockSize * sc.nextCount;
+        void *memory = upstreamResource->allocate(bytes, alignof(std::max_align_t));
+        chunks = ::new (memory) Chunk{chunks, bytes};
+        reserved += bytes;
+        sc.cursor = static_cast<unsigned char *>(memory) + sizeof(Chunk);
+        sc.limit = sc.cursor + sc.blockSize * sc.nextCount;
+        sc.nextCount = std::min(sc.nextCount * 2, std::max<std::size_t>(16, kMaxChunkBytes / sc.blockSize));
+    }
+
+    std::pmr::memory_resource *upstreamResource;
+    std::array<SizeClass, kClassCount> classes;
+    Chunk *chunks = nullptr;
+    std::size_t reserved = 0;
+};
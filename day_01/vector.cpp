@@ -1,73 +1,110 @@
 #include <iostream>
 #include <algorithm>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <stdexcept>
 #include <utility>
+
+#include "../common/container_stats.h"
+#include "../common/memory_resources.h"
  
-template <typename T>
-class Vector {
+template <typename T, typename Allocator = std::allocator<T>, typename Stats = DefaultStats>
+class Vector : private AllocatorHolder<Allocator>, private Stats {
+    using Holder = AllocatorHolder<Allocator>;
+    using AllocTraits = std::allocator_traits<Allocator>;
+    static_assert(std::is_same<typename AllocTraits::pointer, T*>::value, "Vector requires an allocator with raw pointers");
+
 private:
     T* elements;        // 指向动态数组的指针
     size_t capacity;    // 数组的容量
     size_t size;        // 数组中元素的个数
  
 public:
+    using allocator_type = Allocator;
+
     Vector() : elements(nullptr), capacity(0), size(0) {}
 
+    explicit Vector(const Allocator& alloc) : Holder(alloc), elements(nullptr), capacity(0), size(0) {}
+
     ~Vector() {
         clear();
-        ::operator delete(elements);
+        deallocate(elements, capacity);
     }
  
-    Vector(const Vector& other) : capacity(other.capacity), size(other.size) {
-        elements = static_cast<T*>(::operator new(capacity * sizeof(T)));
+    // 统计数据属于对象本身，拷贝与移动都不随元素一起转移
+    Vector(const Vector& other)
+        : Vector(other, AllocTraits::select_on_container_copy_construction(other.allocator())) {}
+
+    Vector(const Vector& other, const Allocator& alloc)
+        : Holder(alloc), Stats(), elements(nullptr), capacity(other.capacity), size(other.size) {
+        elements = allocate(capacity);
         for (size_t i = 0; i < size; ++i) {
-            new (elements + i) T(other.elements[i]);
+            AllocTraits::construct(this->allocator(), elements + i, other.elements[i]);
         }
     }
  
     Vector(Vector&& other) noexcept
-        : elements(other.elements), capacity(other.capacity), size(other.size) {
+        : Holder(other.allocator()), elements(other.elements), capacity(other.capacity), size(other.size) {
         other.elements = nullptr;
         other.capacity = 0;
         other.size = 0;
     }
  
+    // 副本使用本对象的分配器，交换后内存仍由各自的分配器释放
     Vector& operator=(const Vector& other) {
         if (this != &other) {
-            Vector temp(other);
+            Vector temp(other, this->allocator());
             swap(*this, temp);
         }
         return *this;
     }
  
-    Vector& operator=(Vector&& other) noexcept {
-        if (this != &other) {
-            clear();
-            ::operator delete(elements);
+    Vector& operator=(Vector&& other) noexcept(AllocTraits::propagate_on_container_move_assignment::value ||
+                                               AllocTraits::is_always_equal::value) {
+        if (this == &other) return *this;
+        clear();
+        if (AllocTraits::propagate_on_container_move_assignment::value || this->allocator() == other.allocator()) {
+            deallocate(elements, capacity);
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+                this->allocator() = std::move(other.allocator());
+            }
             elements = other.elements;
             capacity = other.capacity;
             size = other.size;
             other.elements = nullptr;
             other.capacity = 0;
             other.size = 0;
+        } else {
+            // 分配器不同且不随移动传播（如两个不同 arena 上的 pmr::Vector）：只能逐个移动元素
+            reserve(other.size);
+            for (size_t i = 0; i < other.size; ++i) {
+                AllocTraits::construct(this->allocator(), elements + i, std::move(other.elements[i]));
+            }
+            size = other.size;
+            other.clear();
         }
         return *this;
     }
  
     friend void swap(Vector& a, Vector& b) noexcept {
         using std::swap;
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            swap(a.allocator(), b.allocator());
+        }
         swap(a.elements, b.elements);
         swap(a.capacity, b.capacity);
         swap(a.size, b.size);
     }
+
+    allocator_type get_allocator() const { return this->allocator(); }
  
     void push_back(const T& value) {
+        Stats::onOperation();
         if (size >= capacity) {
             reserve(capacity == 0 ? 1 : capacity * 2);
         }
-        new (elements + size) T(value);
+        AllocTraits::construct(this->allocator(), elements + size, value);
         ++size;
     }
  
@@ -89,31 +126,33 @@ public:
         if (index > size) {
             throw std::out_of_range("Index out of range");
         }
+        Stats::onOperation();
         if (size >= capacity) {
             reserve(capacity == 0 ? 1 : capacity * 2);
         }
         if (index < size) {
-            new (elements + size) T(std::move(elements[size - 1]));
+            AllocTraits::construct(this->allocator(), elements + size, std::move(elements[size - 1]));
             for (size_t i = size - 1; i > index; --i) {
                 elements[i] = std::move(elements[i - 1]);
             }
             elements[index] = value;
         } else {
-            new (elements + size) T(value);
+            AllocTraits::construct(this->allocator(), elements + size, value);
         }
         ++size;
     }
  
     void pop_back() {
         if (size > 0) {
+            Stats::onOperation();
             --size;
-            elements[size].~T();
+            AllocTraits::destroy(this->allocator(), elements + size);
         }
     }
  
     void clear() {
         for (size_t i = 0; i < size; ++i) {
-            elements[i].~T();
+            AllocTraits::destroy(this->allocator(), elements + i);
         }
         size = 0;
     }
@@ -124,17 +163,34 @@ public:
     T* end() { return elements + size; }
     const T* begin() const { return elements; }
     const T* end() const { return elements + size; }
+
+    StatsSnapshot stats() const { return Stats::snapshot(); }
+    void setStatsDump(StatsDumpHook hook, std::uint64_t everyOps) { Stats::setDumpHook(std::move(hook), everyOps); }
+    void resetStats() { Stats::resetStats(); }
  
 private:
+    T* allocate(size_t n) { return n ? AllocTraits::allocate(this->allocator(), n) : nullptr; }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (p) AllocTraits::deallocate(this->allocator(), p, n);
+    }
+
     void reserve(size_t new_capacity) {
         if (new_capacity <= capacity) return;
-        T* new_elements = static_cast<T*>(::operator new(new_capacity * sizeof(T)));
+        typename Stats::Stopwatch pause;
+        T* new_elements = allocate(new_capacity);
         for (size_t i = 0; i < size; ++i) {
-            new (new_elements + i) T(std::move(elements[i]));
-            elements[i].~T();
+            AllocTraits::construct(this->allocator(), new_elements + i, std::move(elements[i]));
+            AllocTraits::destroy(this->allocator(), elements + i);
         }
-        ::operator delete(elements);
+        deallocate(elements, capacity);
         elements = new_elements;
         capacity = new_capacity;
+        Stats::onGrow(size, new_capacity * sizeof(T), pause.elapsedNanos());
     }
 };
+
+namespace pmr {
+template <typename T, typename Stats = DefaultStats>
+using Vector = ::Vector<T, std::pmr::polymorphic_allocator<T>, Stats>;
+}
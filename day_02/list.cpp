@@ -1,73 +1,273 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
 #include <memory>
+#include <memory_resource>
+#include <new>
 #include <stdexcept>
 #include <sstream>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
-template<typename T>
+// 节点内存取自 Allocator（按块申请），元素经 allocator_traits::construct 在节点中构造，
+// 因此 pmr::List<std::pmr::string> 的元素也从同一个 memory_resource 取内存
+template<typename T, typename Allocator = std::allocator<T>>
 class List {
 public:
-    template <typename L>
-    friend std::ostream &operator<<(std::ostream &os, const List<L> &list);
+    template <typename L, typename A>
+    friend std::ostream &operator<<(std::ostream &os, const List<L, A> &list);
+
+    using allocator_type = Allocator;
 
 private:
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    // data 放在匿名联合里：Node 的构造 / 析构不碰元素，元素由分配器单独构造和销毁
     struct Node {
-        T data;
-        std::unique_ptr<Node> next;
+        union {
+            T data;
+        };
+        Node *next;
         Node *prev;
-        Node(const T &value, std::unique_ptr<Node> nextNode, Node *prevNode)
-            : data(value), next(std::move(nextNode)), prev(prevNode) {}
+        Node(Node *nextNode, Node *prevNode) : next(nextNode), prev(prevNode) {}
+        ~Node() {}
     };
 
-    std::unique_ptr<Node> head;
+    // 平凡析构的元素配标准分配器时 destroy 没有任何效果，clear 可以跳过逐个遍历
+    static constexpr bool kSkipDestroy =
+        std::is_trivially_destructible<T>::value &&
+        (std::is_same<Allocator, std::allocator<T>>::value ||
+         std::is_same<Allocator, std::pmr::polymorphic_allocator<T>>::value);
+
+    // 节点池：按块连续分配节点，释放的节点挂到空闲链表上复用，clear 时整块归还
+    class NodePool {
+        union Slot {
+            Slot *nextFree;
+            alignas(Node) unsigned char storage[sizeof(Node)];
+        };
+
+        struct ChunkRecord {
+            Slot *slots;
+            size_t count;
+        };
+
+        using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+        using SlotTraits = std::allocator_traits<SlotAllocator>;
+        using ChunkAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<ChunkRecord>;
+
+        static constexpr size_t kMinChunk = 32;
+        static constexpr size_t kMaxChunk = 65536;
+
+        std::vector<ChunkRecord, ChunkAllocator> chunks;  // 块记录与块本身使用同一个分配器
+        Slot *freeList = nullptr;
+        Slot *cursor = nullptr;      // 当前块中尚未使用的第一个槽
+        Slot *chunkEnd = nullptr;
+        size_t nextChunk = kMinChunk;
+
+    public:
+        NodePool() = default;
+        explicit NodePool(const Allocator &alloc) : chunks(ChunkAllocator(alloc)) {}
+        NodePool(const NodePool &) = delete;
+        NodePool &operator=(const NodePool &) = delete;
+
+        NodePool(NodePool &&other) noexcept
+            : chunks(std::move(other.chunks)),
+              freeList(std::exchange(other.freeList, nullptr)),
+              cursor(std::exchange(other.cursor, nullptr)),
+              chunkEnd(std::exchange(other.chunkEnd, nullptr)),
+              nextChunk(std::exchange(other.nextChunk, kMinChunk)) {
+            other.chunks.clear();
+        }
+
+        NodePool &operator=(NodePool &&other) noexcept {
+            if (this != &other) {
+                chunks = std::move(other.chunks);
+                other.chunks.clear();
+                freeList = std::exchange(other.freeList, nullptr);
+                cursor = std::exchange(other.cursor, nullptr);
+                chunkEnd = std::exchange(other.chunkEnd, nullptr);
+                nextChunk = std::exchange(other.nextChunk, kMinChunk);
+            }
+            return *this;
+        }
+
+        Allocator allocator() const { return Allocator(chunks.get_allocator()); }
+
+        void *allocate() {
+            if (freeList) {
+                Slot *slot = freeList;
+                freeList = slot->nextFree;
+                return slot;
+            }
+            if (cursor == chunkEnd) {
+                SlotAllocator alloc(chunks.get_allocator());
+                chunks.reserve(chunks.size() + 1);
+                Slot *slots = SlotTraits::allocate(alloc, nextChunk);
+                chunks.push_back(ChunkRecord{slots, nextChunk});
+                cursor = slots;
+                chunkEnd = cursor + nextChunk;
+                nextChunk = std::min(nextChunk * 2, kMaxChunk);
+            }
+            return cursor++;
+        }
+
+        void deallocate(void *p) noexcept {
+            Slot *slot = static_cast<Slot *>(p);
+            slot->nextFree = freeList;
+            freeList = slot;
+        }
+
+        // 一次性归还所有块，调用前节点必须已析构
+        void release() noexcept {
+            SlotAllocator alloc(chunks.get_allocator());
+            for (const ChunkRecord &chunk : chunks) {
+                SlotTraits::deallocate(alloc, chunk.slots, chunk.count);
+            }
+            chunks.clear();
+            freeList = cursor = chunkEnd = nullptr;
+            nextChunk = kMinChunk;
+        }
+    };
+
+    Node *head;
     Node *tail;
     size_t size;
+    NodePool pool;
+
+    template <typename... Args>
+    Node *createNode(Node *nextNode, Node *prevNode, Args &&...args) {
+        Node *node = new (pool.allocate()) Node(nextNode, prevNode);
+        try {
+            Allocator alloc = pool.allocator();
+            AllocTraits::construct(alloc, std::addressof(node->data), std::forward<Args>(args)...);
+        } catch (...) {
+            node->~Node();
+            pool.deallocate(node);
+            throw;
+        }
+        return node;
+    }
+
+    void destroyElement(Node *node) noexcept {
+        Allocator alloc = pool.allocator();
+        AllocTraits::destroy(alloc, std::addressof(node->data));
+        node->~Node();
+    }
+
+    void destroyNode(Node *node) noexcept {
+        destroyElement(node);
+        pool.deallocate(node);
+    }
+
+    void unlinkNode(Node *node) noexcept {
+        if (node->prev) {
+            node->prev->next = node->next;
+        } else {
+            head = node->next;
+        }
+        if (node->next) {
+            node->next->prev = node->prev;
+        } else {
+            tail = node->prev;
+        }
+        --size;
+    }
 
 public:
+    // 节点句柄：在节点被删除前一直有效，供 LRU 之类需要 O(1) 定位的上层结构使用
+    using NodeHandle = Node *;
+
     List() : head(nullptr), tail(nullptr), size(0) {}
 
+    explicit List(const Allocator &alloc) : head(nullptr), tail(nullptr), size(0), pool(alloc) {}
+
     ~List() {
         clear();
     }
 
-    void push_back(const T &value) {
-        auto newNode = std::make_unique<Node>(value, nullptr, tail);
+    List(const List &) = delete;
+    List &operator=(const List &) = delete;
+
+    List(List &&other) noexcept
+        : head(other.head), tail(other.tail), size(other.size), pool(std::move(other.pool)) {
+        other.head = other.tail = nullptr;
+        other.size = 0;
+    }
+
+    List &operator=(List &&other) noexcept(std::allocator_traits<Allocator>::is_always_equal::value ||
+                                           std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value) {
+        if (this == &other) return *this;
+        clear();
+        if (std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+            get_allocator() == other.get_allocator()) {
+            head = other.head;
+            tail = other.tail;
+            size = other.size;
+            pool = std::move(other.pool);
+            other.head = other.tail = nullptr;
+            other.size = 0;
+        } else {
+            // 分配器不同且不随移动传播：节点不能跨分配器转移，只能逐个移动元素
+            for (Node *node = other.head; node; node = node->next) {
+                emplace_back(std::move(node->data));
+            }
+            other.clear();
+        }
+        return *this;
+    }
+
+    allocator_type get_allocator() const { return pool.allocator(); }
+
+    template <typename... Args>
+    T &emplace_back(Args &&...args) {
+        Node *newNode = createNode(nullptr, tail, std::forward<Args>(args)...);
         if (tail) {
-            tail->next = std::move(newNode);
-            tail = tail->next.get();
+            tail->next = newNode;
         } else {
-            head = std::move(newNode);
-            tail = head.get();
+            head = newNode;
         }
+        tail = newNode;
         ++size;
+        return newNode->data;
     }
 
-    void push_front(const T &value) {
-        auto newNode = std::make_unique<Node>(value, std::move(head), nullptr);
-        if (newNode->next) {
-            newNode->next->prev = newNode.get();
+    template <typename... Args>
+    T &emplace_front(Args &&...args) {
+        Node *newNode = createNode(head, nullptr, std::forward<Args>(args)...);
+        if (head) {
+            head->prev = newNode;
         } else {
-            tail = newNode.get();
+            tail = newNode;
         }
-        head = std::move(newNode);
+        head = newNode;
         ++size;
+        return newNode->data;
     }
 
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+    void push_front(const T &value) { emplace_front(value); }
+    void push_front(T &&value) { emplace_front(std::move(value)); }
+
     T &operator[](size_t index) {
-        Node *current = head.get();
+        Node *current = head;
         for (size_t i = 0; i < index; ++i) {
             if (!current) throw std::out_of_range("Index out of range");
-            current = current->next.get();
+            current = current->next;
         }
         if (!current) throw std::out_of_range("Index out of range");
         return current->data;
     }
 
     const T &operator[](size_t index) const {
-        Node *current = head.get();
+        Node *current = head;
         for (size_t i = 0; i < index; ++i) {
             if (!current) throw std::out_of_range("Index out of range");
-            current = current->next.get();
+            current = current->next;
         }
         if (!current) throw std::out_of_range("Index out of range");
         return current->data;
@@ -75,34 +275,24 @@ public:
 
     void pop_back() {
         if (size > 0) {
-            if (tail->prev) {
-                tail = tail->prev;
-                tail->next.reset();
-            } else {
-                head.reset();
-                tail = nullptr;
-            }
-            --size;
+            Node *node = tail;
+            unlinkNode(node);
+            destroyNode(node);
         }
     }
 
     void pop_front() {
         if (size > 0) {
-            if (head->next) {
-                head = std::move(head->next);
-                head->prev = nullptr;
-            } else {
-                head.reset();
-                tail = nullptr;
-            }
-            --size;
+            Node *node = head;
+            unlinkNode(node);
+            destroyNode(node);
         }
     }
 
     Node *getNode(const T &val) {
-        Node *node = head.get();
+        Node *node = head;
         while (node != nullptr && node->data != val) {
-            node = node->next.get();
+            node = node->next;
         }
         return node;
     }
@@ -114,28 +304,39 @@ public:
 
     void remove(const T &val) {
         Node *node = getNode(val);
-        if (!node) return;
+        if (node) eraseNode(node);
+    }
 
-        if (node->prev) {
-            node->prev->next = std::move(node->next);
-        } else {
-            head = std::move(node->next);
-        }
+    NodeHandle frontNode() const { return head; }
+    NodeHandle backNode() const { return tail; }
+    static T &valueOf(NodeHandle node) { return node->data; }
 
-        if (node->next) {
-            node->next->prev = node->prev;
-        } else {
-            tail = node->prev;
-        }
+    void eraseNode(NodeHandle node) {
+        unlinkNode(node);
+        destroyNode(node);
+    }
 
-        --size;
+    void moveToFront(NodeHandle node) {
+        if (node == head) return;
+        unlinkNode(node);
+        ++size;
+        node->prev = nullptr;
+        node->next = head;
+        head->prev = node;
+        head = node;
     }
 
+    // 迭代析构，平凡析构的元素直接整块释放而不必逐个遍历
     void clear() {
-        while (head) {
-            head = std::move(head->next);
+        if (!kSkipDestroy) {
+            for (Node *node = head; node; ) {
+                Node *next = node->next;
+                destroyElement(node);
+                node = next;
+            }
         }
-        tail = nullptr;
+        pool.release();
+        head = tail = nullptr;
         size = 0;
     }
 
@@ -143,10 +344,15 @@ public:
     size_t getSize() const { return size; }
 };
 
-template <typename T>
-std::ostream &operator<<(std::ostream &os, const List<T> &list) {
-    for (typename List<T>::Node *current = list.head.get(); current; current = current->next.get()) {
+template <typename T, typename Allocator>
+std::ostream &operator<<(std::ostream &os, const List<T, Allocator> &list) {
+    for (typename List<T, Allocator>::Node *current = list.head; current; current = current->next) {
         os << current->data << " ";
     }
     return os;
 }
+
+namespace pmr {
+template <typename T>
+using List = ::List<T, std::pmr::polymorphic_allocator<T>>;
+}
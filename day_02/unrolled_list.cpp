@@ -0,0 +1,561 @@
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "../common/memory_resources.h"
+
+// 展开链表：每个块连续存放若干元素，块大小约为一个缓存行。
+// 遍历时大部分访问落在同一块内；块内插入删除只移动常数个元素，所以 insert / erase 为 O(1)。
+// 块的内存取自 Allocator，元素经 allocator_traits::construct 构造。
+template <typename T, size_t ChunkBytes = 64, typename Allocator = std::allocator<T>>
+class UnrolledList : private AllocatorHolder<typename std::allocator_traits<Allocator>::template rebind_alloc<unsigned char>> {
+public:
+    template <typename L, size_t B, typename A>
+    friend std::ostream &operator<<(std::ostream &os, const UnrolledList<L, B, A> &list);
+
+    static constexpr size_t kCapacity = std::max<size_t>(4, ChunkBytes / sizeof(T));
+
+private:
+    struct Link {
+        Link *prev;
+        Link *next;
+        size_t count;
+    };
+
+    struct Chunk : Link {
+        alignas(T) unsigned char storage[kCapacity * sizeof(T)];
+
+        Chunk() : Link{nullptr, nullptr, 0} {}
+        T *data() { return reinterpret_cast<T *>(storage); }
+    };
+
+    static T *elementsOf(Link *link) { return static_cast<Chunk *>(link)->data(); }
+
+    // 块内元素经 allocator_traits 构造与销毁，pmr 下分配器感知的元素也取自同一个 memory_resource
+    template <typename... Args>
+    void constructAt(T *p, Args &&...args) {
+        Allocator alloc(this->allocator());
+        std::allocator_traits<Allocator>::construct(alloc, p, std::forward<Args>(args)...);
+    }
+
+    void destroyAt(T *p) noexcept {
+        Allocator alloc(this->allocator());
+        std::allocator_traits<Allocator>::destroy(alloc, p);
+    }
+
+    // 基类里保存的是字节分配器（Chunk 在此处还不完整），用到时再 rebind 成 Chunk 分配器
+    using ByteAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<unsigned char>;
+    using Holder = AllocatorHolder<ByteAllocator>;
+    using ChunkAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Chunk>;
+    using ChunkTraits = std::allocator_traits<ChunkAllocator>;
+
+    Link sentinel;
+    size_t size;
+
+    // 缓存游标：最近一次非 const operator[] 命中的块及其首元素的下标，顺序下标访问均摊 O(1)。
+    // const 访问只读取游标、不更新，多个线程并发读同一个 const 链表是安全的
+    Link *cursorChunk;
+    size_t cursorBase;
+
+    template <bool IsConst>
+    class Iterator {
+        friend class UnrolledList;
+        Link *chunk = nullptr;
+        size_t index = 0;
+
+        Iterator(Link *c, size_t i) : chunk(c), index(i) {}
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T *, T *>;
+        using reference = std::conditional_t<IsConst, const T &, T &>;
+
+        Iterator() = default;
+
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        Iterator(const Iterator<OtherConst> &other) : chunk(other.chunk), index(other.index) {}
+
+        reference operator*() const { return elementsOf(chunk)[index]; }
+        pointer operator->() const { return &elementsOf(chunk)[index]; }
+
+        Iterator &operator++() {
+            if (++index == chunk->count) {
+                chunk = chunk->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        Iterator &operator--() {
+            if (index == 0) {
+                chunk = chunk->prev;
+                index = chunk->count - 1;
+            } else {
+                --index;
+            }
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        bool operator==(const Iterator &other) const { return chunk == other.chunk && index == other.index; }
+        bool operator!=(const Iterator &other) const { return !(*this == other); }
+    };
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+private:
+    Link *head() const { return sentinel.next; }
+    Link *tail() const { return sentinel.prev; }
+    Link *endLink() const { return const_cast<Link *>(&sentinel); }
+
+    void invalidateCursor() { cursorChunk = nullptr; }
+
+    Chunk *newChunk() {
+        ChunkAllocator alloc(this->allocator());
+        Chunk *chunk = ChunkTraits::allocate(alloc, 1);
+        return ::new (static_cast<void *>(chunk)) Chunk();
+    }
+
+    void deleteChunk(Link *link) noexcept {
+        ChunkAllocator alloc(this->allocator());
+        Chunk *chunk = static_cast<Chunk *>(link);
+        chunk->~Chunk();
+        ChunkTraits::deallocate(alloc, chunk, 1);
+    }
+
+    Chunk *createChunkAfter(Link *pos) {
+        Chunk *chunk = newChunk();
+        chunk->prev = pos;
+        chunk->next = pos->next;
+        pos->next->prev = chunk;
+        pos->next = chunk;
+        return chunk;
+    }
+
+    void destroyChunk(Link *link) noexcept {
+        link->prev->next = link->next;
+        link->next->prev = link->prev;
+        deleteChunk(link);
+    }
+
+    // 把 chunk 中 [from, count) 的元素搬到紧随其后的新块中
+    Link *splitChunk(Link *chunk, size_t from) {
+        Chunk *fresh = createChunkAfter(chunk);
+        T *src = elementsOf(chunk);
+        T *dst = fresh->data();
+        for (size_t i = from; i < chunk->count; ++i) {
+            constructAt(dst + (i - from), std::move(src[i]));
+            destroyAt(&src[i]);
+        }
+        fresh->count = chunk->count - from;
+        chunk->count = from;
+        return fresh;
+    }
+
+    void mergeNext(Link *chunk) noexcept {
+        Link *next = chunk->next;
+        T *src = elementsOf(next);
+        T *dst = elementsOf(chunk);
+        for (size_t i = 0; i < next->count; ++i) {
+            constructAt(dst + chunk->count + i, std::move(src[i]));
+            destroyAt(&src[i]);
+        }
+        chunk->count += next->count;
+        next->count = 0;
+        destroyChunk(next);
+    }
+
+    // 把后一块的前 n 个元素移到 chunk 末尾
+    void borrowFromNext(Link *chunk, size_t n = 1) {
+        Link *next = chunk->next;
+        T *src = elementsOf(next);
+        T *dst = elementsOf(chunk);
+        for (size_t i = 0; i < n; ++i) {
+            constructAt(dst + chunk->count + i, std::move(src[i]));
+        }
+        chunk->count += n;
+        for (size_t i = 0; i + n < next->count; ++i) {
+            src[i] = std::move(src[i + n]);
+        }
+        for (size_t i = next->count - n; i < next->count; ++i) {
+            destroyAt(&src[i]);
+        }
+        next->count -= n;
+    }
+
+    // 把前一块的末尾 n 个元素移到 chunk 开头
+    void borrowFromPrev(Link *chunk, size_t n = 1) {
+        Link *prev = chunk->prev;
+        T *dst = elementsOf(chunk);
+        T *src = elementsOf(prev) + prev->count - n;
+        for (size_t i = chunk->count; i-- > 0;) {
+            if (i + n >= chunk->count) {
+                constructAt(dst + i + n, std::move(dst[i]));
+            } else {
+                dst[i + n] = std::move(dst[i]);
+            }
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (i < chunk->count) {
+                dst[i] = std::move(src[i]);
+            } else {
+                constructAt(dst + i, std::move(src[i]));
+            }
+            destroyAt(&src[i]);
+        }
+        prev->count -= n;
+        chunk->count += n;
+    }
+
+    // 少于半满的块与后一块（末块则与前一块）合并，放不进一块时借足元素补到半满。
+    // 合并不下说明两块之和超过容量，借出后邻块仍不少于半满
+    void rebalance(Link *chunk) {
+        const size_t half = kCapacity / 2;
+        if (chunk == &sentinel || chunk->count >= half) return;
+        if (chunk->next != &sentinel) {
+            if (chunk->count + chunk->next->count <= kCapacity) {
+                mergeNext(chunk);
+            } else {
+                borrowFromNext(chunk, half - chunk->count);
+            }
+        } else if (chunk->prev != &sentinel) {
+            if (chunk->count + chunk->prev->count <= kCapacity) {
+                mergeNext(chunk->prev);
+            } else {
+                borrowFromPrev(chunk, half - chunk->count);
+            }
+        }
+    }
+
+    void stealFrom(UnrolledList &other) noexcept {
+        if (other.size == 0) {
+            sentinel.prev = sentinel.next = &sentinel;
+        } else {
+            sentinel.next = other.sentinel.next;
+            sentinel.prev = other.sentinel.prev;
+            sentinel.next->prev = &sentinel;
+            sentinel.prev->next = &sentinel;
+        }
+        size = other.size;
+        other.sentinel.prev = other.sentinel.next = &other.sentinel;
+        other.size = 0;
+        invalidateCursor();
+        other.invalidateCursor();
+    }
+
+    Link *locate(size_t index, size_t &base) const {
+        if (index >= size) throw std::out_of_range("Index out of range");
+        Link *chunk = head();
+        base = 0;
+        size_t distance = index;
+        const size_t tailBase = size - tail()->count;
+        if (size - index < distance) {
+            chunk = tail();
+            base = tailBase;
+            distance = size - index;
+        }
+        if (cursorChunk) {
+            const size_t cursorDistance = index >= cursorBase ? index - cursorBase : cursorBase - index;
+            if (cursorDistance < distance) {
+                chunk = cursorChunk;
+                base = cursorBase;
+            }
+        }
+        while (index < base) {
+            chunk = chunk->prev;
+            base -= chunk->count;
+        }
+        while (index >= base + chunk->count) {
+            base += chunk->count;
+            chunk = chunk->next;
+        }
+        return chunk;
+    }
+
+    static constexpr bool kPropagateOnMove =
+        std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value;
+
+public:
+    UnrolledList() : sentinel{&sentinel, &sentinel, 0}, size(0), cursorChunk(nullptr), cursorBase(0) {}
+
+    explicit UnrolledList(const Allocator &alloc)
+        : Holder(ByteAllocator(alloc)),
+          sentinel{&sentinel, &sentinel, 0}, size(0), cursorChunk(nullptr), cursorBase(0) {}
+
+    ~UnrolledList() {
+        clear();
+    }
+
+    UnrolledList(const UnrolledList &other)
+        : UnrolledList(other,
+                       std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator())) {}
+
+    UnrolledList(const UnrolledList &other, const Allocator &alloc) : UnrolledList(alloc) {
+        for (const T &value : other) {
+            push_back(value);
+        }
+    }
+
+    UnrolledList(UnrolledList &&other) noexcept : UnrolledList(other.get_allocator()) {
+        stealFrom(other);
+    }
+
+    // 副本使用本对象的分配器，块才能直接接管
+    UnrolledList &operator=(const UnrolledList &other) {
+        if (this != &other) {
+            UnrolledList temp(other, get_allocator());
+            clear();
+            stealFrom(temp);
+        }
+        return *this;
+    }
+
+    UnrolledList &operator=(UnrolledList &&other) noexcept(
+        kPropagateOnMove || std::allocator_traits<Allocator>::is_always_equal::value) {
+        if (this == &other) return *this;
+        clear();
+        if (kPropagateOnMove || get_allocator() == other.get_allocator()) {
+            if constexpr (kPropagateOnMove) {
+                this->allocator() = std::move(other.allocator());
+            }
+            stealFrom(other);
+        } else {
+            for (T &value : other) {
+                emplace_back(std::move(value));
+            }
+            other.clear();
+        }
+        return *this;
+    }
+
+    allocator_type get_allocator() const { return allocator_type(this->allocator()); }
+
+    iterator begin() { return iterator(head(), 0); }
+    iterator end() { return iterator(endLink(), 0); }
+    const_iterator begin() const { return const_iterator(head(), 0); }
+    const_iterator end() const { return const_iterator(endLink(), 0); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    // 在 pos 之前构造新元素；所在块已满时对半拆分，返回指向新元素的迭代器
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args &&...args) {
+        Link *chunk = pos.chunk;
+        size_t index = pos.index;
+        if (chunk == &sentinel) {
+            chunk = tail();
+            if (chunk == &sentinel || chunk->count == kCapacity) {
+                chunk = createChunkAfter(chunk);
+            }
+            index = chunk->count;
+        } else if (chunk->count == kCapacity) {
+            const size_t half = kCapacity / 2;
+            Link *upper = splitChunk(chunk, half);
+            if (index > half) {
+                chunk = upper;
+                index -= half;
+            }
+        }
+
+        // 新元素先用分配器构造在块末尾（参数可能引用本链表中的元素，此时还没有元素移动），再转到 index
+        T *elements = elementsOf(chunk);
+        constructAt(elements + chunk->count, std::forward<Args>(args)...);
+        std::rotate(elements + index, elements + chunk->count, elements + chunk->count + 1);
+        ++chunk->count;
+        ++size;
+        invalidateCursor();
+        return iterator(chunk, index);
+    }
+
+    iterator insert(const_iterator pos, const T &value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T &&value) { return emplace(pos, std::move(value)); }
+
+    // 删除 pos 处的元素，返回其后继。块少于半满时先找后一块（末块则找前一块）：
+    // 邻块多于半满就借一个元素，否则两块合并，因此除末块外每块至少半满
+    iterator erase(const_iterator pos) {
+        Link *chunk = pos.chunk;
+        const size_t index = pos.index;
+        T *elements = elementsOf(chunk);
+        for (size_t i = index; i + 1 < chunk->count; ++i) {
+            elements[i] = std::move(elements[i + 1]);
+        }
+        destroyAt(&elements[chunk->count - 1]);
+        --chunk->count;
+        --size;
+        invalidateCursor();
+
+        if (chunk->count == 0) {
+            Link *next = chunk->next;
+            destroyChunk(chunk);
+            return iterator(next, 0);
+        }
+        const size_t half = kCapacity / 2;
+        if (chunk->count < half) {
+            Link *next = chunk->next;
+            Link *prev = chunk->prev;
+            if (next != &sentinel) {
+                // 后继元素若在后一块的开头，借用或合并后正好落在 chunk[index]
+                if (next->count > half) {
+                    borrowFromNext(chunk);
+                } else {
+                    mergeNext(chunk);
+                }
+                return iterator(chunk, index);
+            }
+            if (prev != &sentinel) {
+                if (prev->count > half) {
+                    borrowFromPrev(chunk);
+                    return index + 1 == chunk->count ? end() : iterator(chunk, index + 1);
+                }
+                const size_t offset = prev->count;
+                const bool atEnd = index == chunk->count;
+                mergeNext(prev);
+                return atEnd ? end() : iterator(prev, offset + index);
+            }
+        }
+        if (index == chunk->count) {
+            return iterator(chunk->next, 0);
+        }
+        return iterator(chunk, index);
+    }
+
+    // 把 other 的全部元素移到 pos 之前；只在 pos 位于块中间时拆分一次。
+    // 接缝两侧的块（拆分出的两半、原来的末块、other 的末块）随后按 erase 的规则借用或合并，
+    // 仍保持除末块外每块至少半满。两者分配器不同时块不能转移，退化为逐个移动元素
+    void splice(const_iterator pos, UnrolledList &other) {
+        if (this == &other || other.size == 0) return;
+        if (!(get_allocator() == other.get_allocator())) {
+            for (T &value : other) {
+                pos = ++emplace(pos, std::move(value));
+            }
+            other.clear();
+            return;
+        }
+        Link *before = pos.chunk;
+        if (pos.index > 0) {
+            before = splitChunk(pos.chunk, pos.index);
+        }
+        Link *first = other.sentinel.next;
+        Link *last = other.sentinel.prev;
+        Link *left = before->prev;
+        first->prev = before->prev;
+        before->prev->next = first;
+        last->next = before;
+        before->prev = last;
+        size += other.size;
+        other.sentinel.prev = other.sentinel.next = &other.sentinel;
+        other.size = 0;
+        invalidateCursor();
+        other.invalidateCursor();
+
+        // 从右向左处理：每一步只会释放当前块或其后继，左侧尚未处理的块保持有效
+        rebalance(before);
+        rebalance(last);
+        rebalance(left);
+    }
+
+    void splice(const_iterator pos, UnrolledList &&other) { splice(pos, other); }
+
+    template <typename... Args>
+    T &emplace_back(Args &&...args) { return *emplace(end(), std::forward<Args>(args)...); }
+
+    template <typename... Args>
+    T &emplace_front(Args &&...args) { return *emplace(begin(), std::forward<Args>(args)...); }
+
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+    void push_front(const T &value) { emplace_front(value); }
+    void push_front(T &&value) { emplace_front(std::move(value)); }
+
+    void pop_back() {
+        if (size > 0) erase(const_iterator(tail(), tail()->count - 1));
+    }
+
+    void pop_front() {
+        if (size > 0) erase(begin());
+    }
+
+    T &front() { return *begin(); }
+    T &back() { return elementsOf(tail())[tail()->count - 1]; }
+
+    T &operator[](size_t index) {
+        size_t base;
+        Link *chunk = locate(index, base);
+        cursorChunk = chunk;
+        cursorBase = base;
+        return elementsOf(chunk)[index - base];
+    }
+
+    const T &operator[](size_t index) const {
+        size_t base;
+        Link *chunk = locate(index, base);
+        return elementsOf(chunk)[index - base];
+    }
+
+    iterator find(const T &val) {
+        return std::find(begin(), end(), val);
+    }
+
+    void remove(const T &val) {
+        iterator it = find(val);
+        if (it != end()) erase(it);
+    }
+
+    void clear() {
+        Link *chunk = head();
+        while (chunk != &sentinel) {
+            Link *next = chunk->next;
+            T *elements = elementsOf(chunk);
+            for (size_t i = 0; i < chunk->count; ++i) {
+                destroyAt(&elements[i]);
+            }
+            deleteChunk(chunk);
+            chunk = next;
+        }
+        sentinel.prev = sentinel.next = &sentinel;
+        size = 0;
+        invalidateCursor();
+    }
+
+    bool empty() const { return size == 0; }
+    size_t getSize() const { return size; }
+};
+
+template <typename T, size_t B, typename Allocator>
+std::ostream &operator<<(std::ostream &os, const UnrolledList<T, B, Allocator> &list) {
+    for (const T &value : list) {
+        os << value << " ";
+    }
+    return os;
+}
+
+namespace pmr {
+template <typename T, size_t ChunkBytes = 64>
+using UnrolledList = ::UnrolledList<T, ChunkBytes, std::pmr::polymorphic_allocator<T>>;
+}
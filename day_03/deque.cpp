@@ -1,12 +1,20 @@
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <sstream>
 #include <string>
 #include <new>
 #include <utility>
 
-template <typename T>
-class Deque {
+#include "../common/container_stats.h"
+#include "../common/memory_resources.h"
+
+template <typename T, typename Allocator = std::allocator<T>, typename Stats = DefaultStats>
+class Deque : private AllocatorHolder<Allocator>, private Stats {
+    using Holder = AllocatorHolder<Allocator>;
+    using AllocTraits = std::allocator_traits<Allocator>;
+    static_assert(std::is_same<typename AllocTraits::pointer, T*>::value, "Deque requires an allocator with raw pointers");
+
 private:
     T* elements;        // 存储元素的原始内存指针
     size_t capacity;    // 总容量
@@ -15,18 +23,24 @@ private:
     size_t size_;       // 当前元素数量
 
 public:
+    using allocator_type = Allocator;
+
     Deque() : elements(nullptr), capacity(0), frontIndex(0), backIndex(0), size_(0) {}
 
+    explicit Deque(const Allocator& alloc)
+        : Holder(alloc), elements(nullptr), capacity(0), frontIndex(0), backIndex(0), size_(0) {}
+
     ~Deque() {
         clear();
-        ::operator delete(elements);
+        deallocate();
     }
 
     Deque(const Deque&) = delete;
     Deque& operator=(const Deque&) = delete;
 
     Deque(Deque&& other) noexcept
-        : elements(other.elements),
+        : Holder(other.allocator()),
+          elements(other.elements),
           capacity(other.capacity),
           frontIndex(other.frontIndex),
           backIndex(other.backIndex),
@@ -36,10 +50,15 @@ public:
         other.size_ = 0;
     }
 
-    Deque& operator=(Deque&& other) noexcept {
-        if (this != &other) {
-            clear();
-            ::operator delete(elements);
+    Deque& operator=(Deque&& other) noexcept(AllocTraits::propagate_on_container_move_assignment::value ||
+                                             AllocTraits::is_always_equal::value) {
+        if (this == &other) return *this;
+        clear();
+        if (AllocTraits::propagate_on_container_move_assignment::value || this->allocator() == other.allocator()) {
+            deallocate();
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+                this->allocator() = std::move(other.allocator());
+            }
             elements = other.elements;
             capacity = other.capacity;
             frontIndex = other.frontIndex;
@@ -48,37 +67,49 @@ public:
             other.elements = nullptr;
             other.capacity = 0;
             other.size_ = 0;
+        } else {
+            // 分配器不同且不随移动传播：按顺序逐个移动元素
+            while (!other.empty()) {
+                push_back(std::move(other[0]));
+                other.pop_front();
+            }
         }
         return *this;
     }
 
+    allocator_type get_allocator() const { return this->allocator(); }
+
     template <typename U>
     void push_front(U&& value) {
+        Stats::onOperation();
         ensure_capacity();
         frontIndex = (frontIndex - 1 + capacity) % capacity;
-        new (&elements[frontIndex]) T(std::forward<U>(value));
+        AllocTraits::construct(this->allocator(), elements + frontIndex, std::forward<U>(value));
         ++size_;
     }
 
     template <typename U>
     void push_back(U&& value) {
+        Stats::onOperation();
         ensure_capacity();
-        new (&elements[backIndex]) T(std::forward<U>(value));
+        AllocTraits::construct(this->allocator(), elements + backIndex, std::forward<U>(value));
         backIndex = (backIndex + 1) % capacity;
         ++size_;
     }
 
     void pop_front() {
         if (empty()) throw std::out_of_range("Deque is empty");
-        elements[frontIndex].~T();
+        Stats::onOperation();
+        AllocTraits::destroy(this->allocator(), elements + frontIndex);
         frontIndex = (frontIndex + 1) % capacity;
         --size_;
     }
 
     void pop_back() {
         if (empty()) throw std::out_of_range("Deque is empty");
+        Stats::onOperation();
         backIndex = (backIndex - 1 + capacity) % capacity;
-        elements[backIndex].~T();
+        AllocTraits::destroy(this->allocator(), elements + backIndex);
         --size_;
     }
 
@@ -97,36 +128,53 @@ public:
     size_t size() const noexcept { return size_; }
     bool empty() const noexcept { return size_ == 0; }
 
+    // 直接析构元素而不经过 pop_back，避免把清空计入操作次数
     void clear() noexcept {
-        while (!empty()) {
-            pop_back();
+        for (size_t i = 0; i < size_; ++i) {
+            AllocTraits::destroy(this->allocator(), elements + (frontIndex + i) % capacity);
         }
+        size_ = 0;
         frontIndex = backIndex = 0;
     }
 
+    StatsSnapshot stats() const { return Stats::snapshot(); }
+    void setStatsDump(StatsDumpHook hook, std::uint64_t everyOps) { Stats::setDumpHook(std::move(hook), everyOps); }
+    void resetStats() { Stats::resetStats(); }
+
 private:
+    void deallocate() noexcept {
+        if (elements) AllocTraits::deallocate(this->allocator(), elements, capacity);
+    }
+
     void ensure_capacity() {
-        if (size_ < capacity) return;）
+        if (size_ < capacity) return;
         const size_t new_cap = (capacity == 0) ? 1 : capacity * 2;
-        T* new_elements = static_cast<T*>(::operator new(new_cap * sizeof(T)));
+        typename Stats::Stopwatch pause;
+        T* new_elements = AllocTraits::allocate(this->allocator(), new_cap);
         size_t new_front = 0;
         try {
             for (size_t i = 0; i < size_; ++i) {
                 const size_t pos = (frontIndex + i) % capacity;
-                new (&new_elements[i]) T(std::move(elements[pos]));
-                elements[pos].~T();
+                AllocTraits::construct(this->allocator(), new_elements + i, std::move(elements[pos]));
+                AllocTraits::destroy(this->allocator(), elements + pos);
             }
         } catch (...) {
             for (size_t j = 0; j < new_front; ++j) {
-                new_elements[j].~T();
+                AllocTraits::destroy(this->allocator(), new_elements + j);
             }
-            ::operator delete(new_elements);
+            AllocTraits::deallocate(this->allocator(), new_elements, new_cap);
             throw;
         }
-        ::operator delete(elements);
+        deallocate();
         elements = new_elements;
         capacity = new_cap;
         frontIndex = 0;
         backIndex = size_;
+        Stats::onGrow(size_, new_cap * sizeof(T), pause.elapsedNanos());
     }
 };
+
+namespace pmr {
+template <typename T, typename Stats = DefaultStats>
+using Deque = ::Deque<T, std::pmr::polymorphic_allocator<T>, Stats>;
+}
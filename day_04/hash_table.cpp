@@ -1,48 +1,37 @@
+#pragma once
+
 #include <algorithm>
 #include <cstddef>
 #include <functional>
 #include <iostream>
 #include <list>
+#include <memory>
+#include <memory_resource>
 #include <utility>
 #include <vector>
 #include <sstream>
 #include <string>
+
+#include "../common/container_stats.h"
   
-template <typename Key, typename Value, typename Hash = std::hash<Key>>
-class HashTable
+// 桶数组与链表节点都取自 Allocator（分别 rebind 成桶和节点类型），键值经 allocator_traits 在节点中构造
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>, typename Stats = DefaultStats>
+class HashTable : private Stats
 {
-    class HashNode {
-    public:
-        Key key;
-        Value value;
+    // 节点就是 std::pair<const Key, Value>：分配器构造 pair 时会把自身传给键和值（uses-allocator），
+    // pmr 下键值自己的内存（例如 std::pmr::string）也取自同一个 memory_resource
+    using HashNode = std::pair<const Key, Value>;
   
-        explicit HashNode(const Key &key) : key(key), value() {}
-        HashNode(const Key &key, const Value &value) : key(key), value(value) {}
-  
-        bool operator==(const HashNode &other) const {
-            return key == other.key;
-        }
-  
-        bool operator!=(const HashNode &other) const {
-            return key != other.key;
-        }
-  
-        bool operator<(const HashNode &other) const {
-            return key < other.key;
-        }
-  
-        bool operator>(const HashNode &other) const {
-            return key > other.key;
-        }
-  
-        bool operator==(const Key &key_) {
-            return key == key_;
-        }
-    };
+    static auto matches(const Key &key) {
+        return [&key](const HashNode &node) { return node.first == key; };
+    }
   
 private:
-    using Bucket = std::list<HashNode>;
-    std::vector<Bucket> buckets;
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<HashNode>;
+    using Bucket = std::list<HashNode, NodeAllocator>;
+    using BucketAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Bucket>;
+    std::vector<Bucket, BucketAllocator> buckets;
     Hash hashFunction;
     size_t tableSize;
     size_t numElements;
@@ -50,31 +39,96 @@ private:
     float maxLoadFactor = 0.75;
   
     size_t hash(const Key &key) const { return hashFunction(key) % tableSize; }
-  
+
+    // 统计不随赋值转移，只复制表的形状
+    void assignShape(const HashTable &other) {
+        hashFunction = other.hashFunction;
+        tableSize = other.tableSize;
+        numElements = other.numElements;
+        maxLoadFactor = other.maxLoadFactor;
+    }
+
+    // 所有桶共用同一个分配器，节点直接 splice 到新桶，不重新分配也不复制元素
     void rehash(size_t newSize) {
-        std::vector<Bucket> newBuckets(newSize);
+        typename Stats::Stopwatch pause;
+        std::vector<Bucket, BucketAllocator> newBuckets(newSize, Bucket(NodeAllocator(buckets.get_allocator())),
+                                                        buckets.get_allocator());
         for (Bucket &bucket : buckets) {
-            for (HashNode &hashNode : bucket) {
-                size_t newIndex = hashFunction(hashNode.key) % newSize;
-                newBuckets[newIndex].push_back(hashNode);
+            while (!bucket.empty()) {
+                Bucket &target = newBuckets[hashFunction(bucket.front().first) % newSize];
+                target.splice(target.end(), bucket, bucket.begin());
             }
         }
-        buckets = std::move(newBuckets);
+        // 新旧桶数组分配器相同，交换即可；移动赋值在 pmr 下会实例化逐元素赋值，而 pair<const Key, Value> 不可赋值
+        buckets.swap(newBuckets);
         tableSize = newSize;
+        // 即使是空钩子，实参求值也会改变 GCC 对 rehash 的寄存器分配；NullStats 下整条语句不实例化
+        if constexpr (Stats::enabled) {
+            Stats::onGrow(numElements, newSize * sizeof(Bucket), pause.elapsedNanos());
+        }
     }
   
 public:
-    HashTable(size_t size = 10, const Hash &hashFunc = Hash()) : buckets(size), hashFunction(hashFunc), tableSize(size), numElements(0) {}
-  
+    using allocator_type = Allocator;
+
+    HashTable(size_t size = 10, const Hash &hashFunc = Hash(), const Allocator &alloc = Allocator())
+        : buckets(size, Bucket(NodeAllocator(alloc)), BucketAllocator(alloc)), hashFunction(hashFunc), tableSize(size), numElements(0) {}
+
+    explicit HashTable(const Allocator &alloc) : HashTable(10, Hash(), alloc) {}
+
+    HashTable(const HashTable &) = default;
+    HashTable(HashTable &&) = default;
+
+    // 节点是 pair<const Key, Value>，不能逐元素赋值：按本对象的分配器逐桶复制出新数组后交换
+    HashTable &operator=(const HashTable &other) {
+        if (this != &other) {
+            std::vector<Bucket, BucketAllocator> copy(buckets.get_allocator());
+            copy.reserve(other.buckets.size());
+            for (const Bucket &bucket : other.buckets) {
+                copy.emplace_back(bucket);
+            }
+            buckets.swap(copy);
+            assignShape(other);
+        }
+        return *this;
+    }
+
+    HashTable &operator=(HashTable &&other) {
+        if (this == &other) return *this;
+        if constexpr (std::allocator_traits<BucketAllocator>::propagate_on_container_move_assignment::value) {
+            buckets = std::move(other.buckets);
+        } else if (buckets.get_allocator() == other.buckets.get_allocator()) {
+            std::vector<Bucket, BucketAllocator> stolen(std::move(other.buckets));
+            buckets.swap(stolen);
+        } else {
+            // 分配器不同且不随移动传播：节点不能跨分配器转移，逐桶移动元素到本对象的分配器
+            std::vector<Bucket, BucketAllocator> moved(buckets.get_allocator());
+            moved.reserve(other.buckets.size());
+            for (Bucket &bucket : other.buckets) {
+                moved.emplace_back(std::move(bucket));
+            }
+            buckets.swap(moved);
+            other.buckets.clear();
+        }
+        assignShape(other);
+        other.numElements = 0;
+        other.tableSize = 0;
+        return *this;
+    }
+
+    allocator_type get_allocator() const { return allocator_type(buckets.get_allocator()); }
+
     void insert(const Key &key, const Value &value) {
         if ((numElements + 1) > maxLoadFactor * tableSize) {
             if (tableSize == 0) tableSize = 1;
             rehash(tableSize * 2);
         }
         size_t index = hash(key);
-        std::list<HashNode> &bucket = buckets[index];
-        if (std::find(bucket.begin(), bucket.end(), key) == bucket.end()) {
-            bucket.push_back(HashNode(key, value));
+        Bucket &bucket = buckets[index];
+        Stats::onOperation();
+        Stats::onChain(bucket.size());
+        if (std::find_if(bucket.begin(), bucket.end(), matches(key)) == bucket.end()) {
+            bucket.emplace_back(key, value);
             ++numElements;
         }
     }
@@ -84,7 +138,9 @@ public:
     void erase(const Key &key) {
         size_t index = hash(key);
         auto &bucket = buckets[index];
-        auto it = std::find(bucket.begin(), bucket.end(), key);
+        Stats::onOperation();
+        Stats::onChain(bucket.size());
+        auto it = std::find_if(bucket.begin(), bucket.end(), matches(key));
         if (it != bucket.end()) {
             bucket.erase(it);
             numElements--;
@@ -94,18 +150,32 @@ public:
     Value *find(const Key &key) {
         size_t index = hash(key);
         auto &bucket = buckets[index];
-        auto it = std::find(bucket.begin(), bucket.end(), key);
+        Stats::onOperation();
+        Stats::onChain(bucket.size());
+        auto it = std::find_if(bucket.begin(), bucket.end(), matches(key));
         if (it != bucket.end()) {
-            return &it->value;
+            return &it->second;
         };
         return nullptr;
     }
   
     size_t size() const { return numElements; }
+
+    // 链长取自目标桶的元素个数；rehash 停顿记在 growPauseNanos
+    StatsSnapshot stats() const { return Stats::snapshot(); }
+    void setStatsDump(StatsDumpHook hook, std::uint64_t everyOps) { Stats::setDumpHook(std::move(hook), everyOps); }
+    void resetStats() { Stats::resetStats(); }
   
+    // 保留桶数组：清空后 find / erase 仍然可以直接取模
     void clear() {
-        this->buckets.clear();
+        for (Bucket &bucket : this->buckets) {
+            bucket.clear();
+        }
         this->numElements = 0;
-        this->tableSize = 0;
     }
 };
+
+namespace pmr {
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Stats = DefaultStats>
+using HashTable = ::HashTable<Key, Value, Hash, std::pmr::polymorphic_allocator<std::pair<const Key, Value>>, Stats>;
+}
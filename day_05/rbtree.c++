@@ -1,42 +1,97 @@
 #include <iostream>
+#include <memory>
+#include <new>
 #include <sstream>
 #include <string>
 
+#include "../common/container_stats.h"
+#include "../common/memory_resources.h"
+
 enum class Color { RED, BLACK };
 
-template <typename Key, typename Value>
-class RedBlackTree {
+// 节点（包括哨兵 Nil）的内存取自 Allocator，按节点类型 rebind 后逐个申请；
+// 键和值分别经 rebind 到各自类型的 allocator_traits::construct 构造，pmr 下它们自己的内存也取自同一资源
+template <typename Key, typename Value, typename Allocator = std::allocator<std::pair<const Key, Value>>,
+          typename Stats = DefaultStats>
+class RedBlackTree : private AllocatorHolder<Allocator>, private Stats {
+    // 键和值放在匿名联合里，由 createNode / destroyNode 经分配器单独构造和销毁
     class Node {
     public:
-        Key key;
-        Value value;
+        union {
+            Key key;
+        };
+        union {
+            Value value;
+        };
         Color color;
         Node *left;
         Node *right;
         Node *parent;
 
-        Node(const Key &k, const Value &v, Color c, Node *p = nullptr)
-            : key(k), value(v), color(c), left(nullptr), right(nullptr), parent(p) {}
-
-        Node() : color(Color::BLACK), left(nullptr), right(nullptr), parent(nullptr) {}
+        explicit Node(Color c, Node *p = nullptr) : color(c), left(nullptr), right(nullptr), parent(p) {}
+        ~Node() {}
     };
 
+    using Holder = AllocatorHolder<Allocator>;
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+    using KeyAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Key>;
+    using KeyTraits = std::allocator_traits<KeyAllocator>;
+    using ValueAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Value>;
+    using ValueTraits = std::allocator_traits<ValueAllocator>;
+
 private:
     Node *root;
     size_t size;
     Node *Nil;
 
-    Node *lookUp(Key key) {
+    template <typename K, typename... ValueArgs>
+    Node *createNode(Color color, K &&key, ValueArgs &&...valueArgs) {
+        NodeAllocator alloc(this->allocator());
+        KeyAllocator keyAlloc(this->allocator());
+        ValueAllocator valueAlloc(this->allocator());
+        Node *node = ::new (static_cast<void *>(NodeTraits::allocate(alloc, 1))) Node(color);
+        try {
+            KeyTraits::construct(keyAlloc, std::addressof(node->key), std::forward<K>(key));
+            try {
+                ValueTraits::construct(valueAlloc, std::addressof(node->value), std::forward<ValueArgs>(valueArgs)...);
+            } catch (...) {
+                KeyTraits::destroy(keyAlloc, std::addressof(node->key));
+                throw;
+            }
+        } catch (...) {
+            node->~Node();
+            NodeTraits::deallocate(alloc, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    void destroyNode(Node *node) noexcept {
+        NodeAllocator alloc(this->allocator());
+        KeyAllocator keyAlloc(this->allocator());
+        ValueAllocator valueAlloc(this->allocator());
+        ValueTraits::destroy(valueAlloc, std::addressof(node->value));
+        KeyTraits::destroy(keyAlloc, std::addressof(node->key));
+        node->~Node();
+        NodeTraits::deallocate(alloc, node, 1);
+    }
+
+    Node *lookUp(const Key &key) {
         Node *cmpNode = root;
+        size_t levels = 0;
         while (cmpNode) {
+            ++levels;
             if (key < cmpNode->key) cmpNode = cmpNode->left;
             else if (key > cmpNode->key) cmpNode = cmpNode->right;
-            else return cmpNode;
+            else break;
         }
-        return nullptr;
+        Stats::onDepth(levels);
+        return cmpNode;
     }
 
     void rightRotate(Node *node) {
+        Stats::onRotate();
         Node *l_son = node->left;
         node->left = l_son->right;
         if (l_son->right) l_son->right->parent = node;
@@ -49,6 +104,7 @@ private:
     }
 
     void leftRotate(Node *node) {
+        Stats::onRotate();
         Node *r_son = node->right;
         node->right = r_son->left;
         if (r_son->left) r_son->left->parent = node;
@@ -100,18 +156,22 @@ private:
     }
 
     void insertNode(const Key &key, const Value &value) {
-        Node *newNode = new Node(key, value, Color::RED);
+        Node *newNode = createNode(Color::RED, key, value);
         Node *parent = nullptr;
         Node *cmpNode = root;
+        size_t levels = 0;
         while (cmpNode) {
+            ++levels;
             parent = cmpNode;
             if (newNode->key < cmpNode->key) cmpNode = cmpNode->left;
             else if (newNode->key > cmpNode->key) cmpNode = cmpNode->right;
             else {
-                delete newNode;
+                Stats::onDepth(levels);
+                destroyNode(newNode);
                 return;
             }
         }
+        Stats::onDepth(levels);
         size++;
         newNode->parent = parent;
         if (!parent) root = newNode;
@@ -293,17 +353,29 @@ private:
                 dieConnectNil();
             }
         }
-        delete del;
+        destroyNode(del);
     }
 
 public:
-    RedBlackTree() : root(nullptr), size(0), Nil(new Node()) {
+    using allocator_type = Allocator;
+
+    RedBlackTree() : root(nullptr), size(0), Nil(createNode(Color::BLACK, Key())) {
+        Nil->color = Color::BLACK;
+    }
+
+    explicit RedBlackTree(const Allocator &alloc) : Holder(alloc), root(nullptr), size(0), Nil(createNode(Color::BLACK, Key())) {
         Nil->color = Color::BLACK;
     }
 
-    void insert(const Key &key, const Value &value) { insertNode(key, value); }
+    allocator_type get_allocator() const { return this->allocator(); }
+
+    void insert(const Key &key, const Value &value) {
+        Stats::onOperation();
+        insertNode(key, value);
+    }
 
     void remove(const Key &key) {
+        Stats::onOperation();
         Node *nodeToBeRemoved = lookUp(key);
         if (nodeToBeRemoved) {
             deleteNode(nodeToBeRemoved);
@@ -312,6 +384,7 @@ public:
     }
 
     Value *at(const Key &key) {
+        Stats::onOperation();
         auto ans = lookUp(key);
         return ans ? &ans->value : nullptr;
     }
@@ -319,6 +392,11 @@ public:
     int getSize() { return size; }
     bool empty() { return size == 0; }
 
+    // depth 记录每次查找 / 插入经过的节点数，rotations 包括插入和删除修复时的旋转
+    StatsSnapshot stats() const { return Stats::snapshot(); }
+    void setStatsDump(StatsDumpHook hook, std::uint64_t everyOps) { Stats::setDumpHook(std::move(hook), everyOps); }
+    void resetStats() { Stats::resetStats(); }
+
     void print() {
         inorderTraversal(root);
         std::cout << std::endl;
@@ -332,7 +410,7 @@ public:
 
     ~RedBlackTree() {
         deleteTree(root);
-        delete Nil;
+        destroyNode(Nil);
     }
 
 private:
@@ -340,7 +418,12 @@ private:
         if (node) {
             deleteTree(node->left);
             deleteTree(node->right);
-            delete node;
+            destroyNode(node);
         }
     }
 };
+
+namespace pmr {
+template <typename Key, typename Value, typename Stats = DefaultStats>
+using RedBlackTree = ::RedBlackTree<Key, Value, std::pmr::polymorphic_allocator<std::pair<const Key, Value>>, Stats>;
+}
@@ -1,6 +1,8 @@
 #include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <vector>
 #include <deque>
 #include <stdexcept>
@@ -8,9 +10,13 @@
 #include <string>
 #include <type_traits>
 #include <memory>
+#include <memory_resource>
 
-template<typename T, typename Container = std::vector<T>, typename Compare = std::less<typename Container::value_type>>
-class MyPriorityQueue {
+#include "../common/container_stats.h"
+
+template<typename T, typename Container = std::vector<T>, typename Compare = std::less<typename Container::value_type>,
+         typename Stats = DefaultStats>
+class MyPriorityQueue : private Stats {
 public:
     using container_type = Container;
     using value_compare = Compare;
@@ -24,19 +30,23 @@ private:
     value_compare comp;
 
     void heapify_up(size_type index) {
+        size_type distance = 0;
         while (index > 0) {
             size_type parent = (index - 1) / 2;
             if (!comp(data[index], data[parent])) {
                 std::swap(data[index], data[parent]);
                 index = parent;
+                ++distance;
             } else {
                 break;
             }
         }
+        Stats::onSift(distance);
     }
 
     void heapify_down(size_type index) {
         const size_type size = data.size();
+        size_type distance = 0;
         while (true) {
             size_type largest = index;
             const size_type left = 2 * index + 1;
@@ -52,10 +62,12 @@ private:
             if (largest != index) {
                 std::swap(data[index], data[largest]);
                 index = largest;
+                ++distance;
             } else {
                 break;
             }
         }
+        Stats::onSift(distance);
     }
 
     void make_heap() {
@@ -93,17 +105,20 @@ public:
     MyPriorityQueue& operator=(MyPriorityQueue&&) noexcept = default;
 
     void push(const value_type& value) {
+        Stats::onOperation();
         data.push_back(value);
         heapify_up(data.size() - 1);
     }
 
     void push(value_type&& value) {
+        Stats::onOperation();
         data.push_back(std::move(value));
         heapify_up(data.size() - 1);
     }
 
     template<typename... Args>
     void emplace(Args&&... args) {
+        Stats::onOperation();
         data.emplace_back(std::forward<Args>(args)...);
         heapify_up(data.size() - 1);
     }
@@ -112,6 +127,7 @@ public:
         if (empty()) {
             throw std::runtime_error("Priority queue is empty");
         }
+        Stats::onOperation();
         std::swap(data.front(), data.back());
         data.pop_back();
         if (!empty()) {
@@ -129,6 +145,11 @@ public:
     [[nodiscard]] bool empty() const noexcept { return data.empty(); }
     [[nodiscard]] size_type size() const noexcept { return data.size(); }
 
+    // siftDistance 记录每次上浮 / 下沉交换的层数，建堆时的下沉也计入
+    [[nodiscard]] StatsSnapshot stats() const { return Stats::snapshot(); }
+    void setStatsDump(StatsDumpHook hook, std::uint64_t everyOps) { Stats::setDumpHook(std::move(hook), everyOps); }
+    void resetStats() { Stats::resetStats(); }
+
     void swap(MyPriorityQueue& other) noexcept(
         noexcept(std::swap(data, other.data)) && 
         noexcept(std::swap(comp, other.comp))) {
@@ -138,10 +159,165 @@ public:
     }
 };
 
-template<typename T, typename Container, typename Compare>
+template<typename T, typename Container, typename Compare, typename Stats>
 void swap(
-    MyPriorityQueue<T, Container, Compare>& lhs,
-    MyPriorityQueue<T, Container, Compare>& rhs
+    MyPriorityQueue<T, Container, Compare, Stats>& lhs,
+    MyPriorityQueue<T, Container, Compare, Stats>& rhs
 ) noexcept(noexcept(lhs.swap(rhs))) {
     lhs.swap(rhs);
 }
+
+// 底层容器本身已可替换，pmr 版本只是换成 std::pmr::vector
+namespace pmr {
+template<typename T, typename Compare = std::less<T>, typename Stats = DefaultStats>
+using MyPriorityQueue = ::MyPriorityQueue<T, std::pmr::vector<T>, Compare, Stats>;
+}
+
+template<typename T>
+struct RadixIdentityKey {
+    const T& operator()(const T& value) const noexcept { return value; }
+};
+
+// 单调整数优先队列：新压入的键不得小于最近一次 top()/pop() 得到的键（事件模拟、Dijkstra）。
+// 元素按 "与上次弹出键的最高不同位" 分桶，pop 均摊 O(log C)，C 为键的跨度。
+template<typename T, typename KeyOf = RadixIdentityKey<T>>
+class RadixHeap {
+public:
+    using value_type = T;
+    using key_type = std::decay_t<decltype(std::declval<const KeyOf&>()(std::declval<const T&>()))>;
+    using const_reference = const T&;
+    using size_type = std::size_t;
+
+    static_assert(std::is_integral<key_type>::value && std::is_unsigned<key_type>::value,
+                  "RadixHeap requires an unsigned integral key");
+
+private:
+    static constexpr size_type bucket_count = std::numeric_limits<key_type>::digits + 1;
+
+    mutable std::vector<T> buckets[bucket_count];  // buckets[0] 只存放键等于 last 的元素
+    mutable key_type last = 0;
+    size_type count = 0;
+    KeyOf key_of;
+
+    static size_type bucket_index(key_type key, key_type base) noexcept {
+        key_type diff = key ^ base;
+        if (diff == 0) return 0;
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_type>(64 - __builtin_clzll(static_cast<unsigned long long>(diff)));
+#else
+        size_type width = 0;
+        while (diff) { diff >>= 1; ++width; }
+        return width;
+#endif
+    }
+
+    // 把第一个非空桶按新的最小键重新分配到更低的桶中，保证 buckets[0] 非空
+    void pull() const {
+        if (!buckets[0].empty()) return;
+        size_type i = 1;
+        while (buckets[i].empty()) ++i;
+        std::vector<T>& source = buckets[i];
+        key_type new_last = key_of(source.front());
+        for (const T& value : source) {
+            new_last = std::min<key_type>(new_last, key_of(value));
+        }
+        last = new_last;
+        for (T& value : source) {
+            buckets[bucket_index(key_of(value), last)].push_back(std::move(value));
+        }
+        source.clear();
+    }
+
+    template<typename U>
+    void insert(U&& value) {
+        const key_type key = key_of(value);
+        if (key < last) {
+            throw std::invalid_argument("RadixHeap key is below the last popped key");
+        }
+        buckets[bucket_index(key, last)].push_back(std::forward<U>(value));
+        ++count;
+    }
+
+public:
+    RadixHeap() = default;
+
+    explicit RadixHeap(const KeyOf& key_func) : key_of(key_func) {}
+
+    void push(const value_type& value) { insert(value); }
+    void push(value_type&& value) { insert(std::move(value)); }
+
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        insert(value_type(std::forward<Args>(args)...));
+    }
+
+    void pop() {
+        if (empty()) {
+            throw std::runtime_error("Priority queue is empty");
+        }
+        pull();
+        buckets[0].pop_back();
+        --count;
+    }
+
+    [[nodiscard]] const_reference top() const {
+        if (empty()) {
+            throw std::runtime_error("Priority queue is empty");
+        }
+        pull();
+        return buckets[0].back();
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return count == 0; }
+    [[nodiscard]] size_type size() const noexcept { return count; }
+
+    // 不释放桶的容量，便于重复使用同一个堆跑多轮模拟
+    void clear() noexcept {
+        for (auto& bucket : buckets) bucket.clear();
+        last = 0;
+        count = 0;
+    }
+
+    void swap(RadixHeap& other) noexcept {
+        using std::swap;
+        for (size_type i = 0; i < bucket_count; ++i) swap(buckets[i], other.buckets[i]);
+        swap(last, other.last);
+        swap(count, other.count);
+        swap(key_of, other.key_of);
+    }
+};
+
+template<typename T, typename KeyOf>
+void swap(RadixHeap<T, KeyOf>& lhs, RadixHeap<T, KeyOf>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// 优先队列实现策略：默认是基于比较的二叉堆，单调整数键可换成基数堆。
+// 每个策略给出自己的默认 Compare：二叉堆沿用 std::less（大根堆），基数堆只能先弹出最小键，
+// 因此默认是 std::greater，传入其他 Compare 会在编译期报错，避免换策略后出队顺序悄悄反转。
+struct BinaryHeapPolicy {
+    template<typename T>
+    using default_compare = std::less<T>;
+
+    template<typename T, typename Compare>
+    using queue = MyPriorityQueue<T, std::vector<T>, Compare>;
+};
+
+template<typename T, typename Compare, typename KeyOf>
+struct RadixQueueFor {
+    static_assert(std::is_same<Compare, std::greater<T>>::value || std::is_same<Compare, std::greater<>>::value,
+                  "RadixHeapPolicy always pops the smallest key; use std::greater as Compare");
+    using type = RadixHeap<T, std::conditional_t<std::is_void<KeyOf>::value, RadixIdentityKey<T>, KeyOf>>;
+};
+
+template<typename KeyOf = void>
+struct RadixHeapPolicy {
+    template<typename T>
+    using default_compare = std::greater<T>;
+
+    template<typename T, typename Compare>
+    using queue = typename RadixQueueFor<T, Compare, KeyOf>::type;
+};
+
+template<typename T, typename Policy = BinaryHeapPolicy, typename Compare = typename Policy::template default_compare<T>>
+using PriorityQueue = typename Policy::template queue<T, Compare>;
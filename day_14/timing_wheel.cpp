@@ -0,0 +1,288 @@
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// 分层时间轮：8 层、每层 256 个槽，覆盖完整的 64 位 tick 空间。
+// schedule / cancel 为 O(1)，advance(now) 批量触发到期定时器，高层槽在进位时逐级下放（cascade）。
+template <typename Callback = std::function<void()>>
+class TimingWheel {
+public:
+    using tick_type = std::uint64_t;
+    using size_type = std::size_t;
+
+private:
+    static constexpr unsigned kSlotBits = 8;
+    static constexpr size_type kSlots = size_type(1) << kSlotBits;
+    static constexpr unsigned kLevels = 64 / kSlotBits;
+    static constexpr size_type kWordsPerLevel = kSlots / 64;
+    static constexpr size_type kNodesPerChunk = 1024;
+
+    struct Link {
+        Link *prev;
+        Link *next;
+    };
+
+    // 定时器节点侵入式地挂在槽的双向链表上，由节点池分配
+    struct Node : Link {
+        tick_type expiry;
+        std::uint32_t generation;
+        std::uint8_t level;
+        std::uint8_t slot;
+        bool armed;
+        Callback callback;
+    };
+
+public:
+    // 定时器句柄：节点被回收复用后 generation 变化，旧句柄的 cancel 会安全地失败
+    class TimerId {
+        friend class TimingWheel;
+        Node *node = nullptr;
+        std::uint32_t generation = 0;
+        TimerId(Node *n, std::uint32_t g) : node(n), generation(g) {}
+
+    public:
+        TimerId() = default;
+        explicit operator bool() const noexcept { return node != nullptr; }
+    };
+
+private:
+    Link slots[kLevels][kSlots];
+    std::uint64_t occupied[kLevels][kWordsPerLevel] = {};
+    tick_type current;
+    size_type count;
+
+    std::vector<std::unique_ptr<Node[]>> chunks;
+    Node *freeList;
+
+    static bool listEmpty(const Link &head) noexcept { return head.next == &head; }
+
+    static void unlink(Link *link) noexcept {
+        link->prev->next = link->next;
+        link->next->prev = link->prev;
+    }
+
+    static void linkBefore(Link *head, Link *link) noexcept {
+        link->prev = head->prev;
+        link->next = head;
+        head->prev->next = link;
+        head->prev = link;
+    }
+
+    static unsigned highestBit(tick_type value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned bit = 0;
+        while (value >>= 1) ++bit;
+        return bit;
+#endif
+    }
+
+    static unsigned lowestBit(std::uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(value));
+#else
+        unsigned bit = 0;
+        while (!(value & 1)) { value >>= 1; ++bit; }
+        return bit;
+#endif
+    }
+
+    Node *allocateNode() {
+        if (!freeList) {
+            std::unique_ptr<Node[]> chunk(new Node[kNodesPerChunk]);
+            for (size_type i = 0; i < kNodesPerChunk; ++i) {
+                chunk[i].generation = 0;
+                chunk[i].armed = false;
+                chunk[i].next = i + 1 < kNodesPerChunk ? &chunk[i + 1] : nullptr;
+            }
+            freeList = &chunk[0];
+            chunks.push_back(std::move(chunk));
+        }
+        Node *node = freeList;
+        freeList = static_cast<Node *>(node->next);
+        return node;
+    }
+
+    void releaseNode(Node *node) noexcept {
+        node->armed = false;
+        ++node->generation;
+        node->next = freeList;
+        freeList = node;
+    }
+
+    // 按到期时间与当前时间的最高不同字节决定所在层：同一层内只需比较该层的槽号
+    void place(Node *node) noexcept {
+        const tick_type diff = node->expiry ^ current;
+        const unsigned level = diff == 0 ? 0 : highestBit(diff) / kSlotBits;
+        const unsigned slot = static_cast<unsigned>(node->expiry >> (level * kSlotBits)) & (kSlots - 1);
+        node->level = static_cast<std::uint8_t>(level);
+        node->slot = static_cast<std::uint8_t>(slot);
+        linkBefore(&slots[level][slot], node);
+        occupied[level][slot / 64] |= std::uint64_t(1) << (slot % 64);
+    }
+
+    // 也用于 fire 中已被摘到局部链表上的节点：此时对应槽已为空，清除占用位是幂等的
+    void detach(Node *node) noexcept {
+        Link &head = slots[node->level][node->slot];
+        unlink(node);
+        if (listEmpty(head)) {
+            occupied[node->level][node->slot / 64] &= ~(std::uint64_t(1) << (node->slot % 64));
+        }
+    }
+
+    // 返回 level 层中槽号 >= from 的第一个非空槽，没有则返回 kSlots
+    size_type nextOccupied(unsigned level, size_type from) const noexcept {
+        for (size_type word = from / 64; word < kWordsPerLevel; ++word) {
+            std::uint64_t bits = occupied[level][word];
+            if (word == from / 64) bits &= ~std::uint64_t(0) << (from % 64);
+            if (bits) return word * 64 + lowestBit(bits);
+        }
+        return kSlots;
+    }
+
+    // 下一个需要处理的时刻：第 0 层为到期时间，高层为该槽开始下放的时间。
+    // 更高层的槽一定晚于低层的任何槽，所以找到的第一个非空槽就是答案
+    bool nextEvent(tick_type &when) const noexcept {
+        for (unsigned level = 0; level < kLevels; ++level) {
+            const unsigned shift = level * kSlotBits;
+            const size_type digit = (current >> shift) & (kSlots - 1);
+            const size_type slot = nextOccupied(level, level == 0 ? digit : digit + 1);
+            if (slot == kSlots) continue;
+            const unsigned upper = shift + kSlotBits;
+            const tick_type prefix = upper >= 64 ? 0 : (current >> upper) << upper;
+            when = prefix | (tick_type(slot) << shift);
+            return true;
+        }
+        return false;
+    }
+
+    // 把整个槽的链表转移到 pending 上并清空该槽
+    bool takeSlot(unsigned level, size_type slot, Link &pending) noexcept {
+        Link &head = slots[level][slot];
+        if (listEmpty(head)) return false;
+        pending.next = head.next;
+        pending.prev = head.prev;
+        pending.next->prev = &pending;
+        pending.prev->next = &pending;
+        head.next = head.prev = &head;
+        occupied[level][slot / 64] &= ~(std::uint64_t(1) << (slot % 64));
+        return true;
+    }
+
+    void cascade(unsigned level, size_type slot) noexcept {
+        Link pending;
+        if (!takeSlot(level, slot, pending)) return;
+        while (!listEmpty(pending)) {
+            Node *node = static_cast<Node *>(pending.next);
+            unlink(node);
+            place(node);
+        }
+    }
+
+    // 先把槽整体摘下，再逐个触发；回调中 schedule / cancel 其他定时器都是安全的。
+    // 回调抛出异常时，尚未触发的节点挂回原槽（它们的到期时间就是 current），下次 advance 会继续触发
+    size_type fire(size_type slot) {
+        struct Restore {
+            TimingWheel &wheel;
+            Link &pending;
+            size_type slot;
+            ~Restore() {
+                if (listEmpty(pending)) return;
+                Link &head = wheel.slots[0][slot];
+                pending.prev->next = head.next;
+                head.next->prev = pending.prev;
+                head.next = pending.next;
+                pending.next->prev = &head;
+                pending.next = pending.prev = &pending;
+                wheel.occupied[0][slot / 64] |= std::uint64_t(1) << (slot % 64);
+            }
+        };
+
+        Link pending;
+        if (!takeSlot(0, slot, pending)) return 0;
+        Restore restore{*this, pending, slot};
+
+        size_type fired = 0;
+        while (!listEmpty(pending)) {
+            Node *node = static_cast<Node *>(pending.next);
+            Callback callback = std::move(node->callback);
+            unlink(node);
+            node->callback = Callback();
+            releaseNode(node);
+            --count;
+            ++fired;
+            callback();
+        }
+        return fired;
+    }
+
+public:
+    explicit TimingWheel(tick_type now = 0) : current(now), count(0), freeList(nullptr) {
+        for (auto &level : slots) {
+            for (Link &head : level) {
+                head.prev = head.next = &head;
+            }
+        }
+    }
+
+    TimingWheel(const TimingWheel &) = delete;
+    TimingWheel &operator=(const TimingWheel &) = delete;
+
+    // 在 expiry 时刻触发；不晚于当前时间的定时器在下一个 tick 触发
+    TimerId schedule(tick_type expiry, Callback callback) {
+        if (current == ~tick_type(0)) {
+            throw std::overflow_error("TimingWheel clock exhausted");
+        }
+        Node *node = allocateNode();
+        node->expiry = expiry > current ? expiry : current + 1;
+        node->armed = true;
+        node->callback = std::move(callback);
+        place(node);
+        ++count;
+        return TimerId(node, node->generation);
+    }
+
+    TimerId scheduleAfter(tick_type delay, Callback callback) {
+        const tick_type expiry = delay > ~tick_type(0) - current ? ~tick_type(0) : current + delay;
+        return schedule(expiry, std::move(callback));
+    }
+
+    // 已触发、已取消或句柄过期时返回 false
+    bool cancel(TimerId id) noexcept {
+        Node *node = id.node;
+        if (!node || node->generation != id.generation || !node->armed) return false;
+        detach(node);
+        node->callback = Callback();
+        releaseNode(node);
+        --count;
+        return true;
+    }
+
+    // 推进时钟到 now，按到期时间顺序批量触发，返回触发的定时器数
+    size_type advance(tick_type now) {
+        size_type fired = 0;
+        tick_type when = 0;
+        while (current < now && nextEvent(when) && when <= now) {
+            current = when;
+            for (unsigned level = kLevels - 1; level > 0; --level) {
+                const unsigned shift = level * kSlotBits;
+                if ((current & ((tick_type(1) << shift) - 1)) == 0) {
+                    cascade(level, (current >> shift) & (kSlots - 1));
+                }
+            }
+            fired += fire(current & (kSlots - 1));
+        }
+        if (current < now) current = now;
+        return fired;
+    }
+
+    tick_type now() const noexcept { return current; }
+    size_type size() const noexcept { return count; }
+    bool empty() const noexcept { return count == 0; }
+};
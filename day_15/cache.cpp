@@ -0,0 +1,499 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../day_02/list.cpp"
+#include "../day_04/hash_table.cpp"
+
+// 有界缓存：List 维护访问顺序，HashTable 保存 key -> 链表节点句柄，get / put / evict 均为 O(1)。
+// 淘汰策略可替换：LRU、分段 LRU（SLRU）、W-TinyLFU（窗口 LRU + 频率准入 + SLRU 主区）。
+
+template <typename Key, typename Value>
+struct CacheEntry {
+    Key key;
+    Value value;
+    unsigned char segment;
+};
+
+// 策略的公共部分：各段链表之间搬移条目、淘汰条目时同步更新索引
+template <typename Key, typename Value, typename Hash>
+class CachePolicyBase {
+public:
+    using Entry = CacheEntry<Key, Value>;
+    using Segment = List<Entry>;
+    using Handle = typename Segment::NodeHandle;
+    using Index = HashTable<Key, Handle, Hash>;
+
+protected:
+    Index &index;
+
+    explicit CachePolicyBase(Index &idx) : index(idx) {}
+
+    static Entry &entryOf(Handle handle) { return Segment::valueOf(handle); }
+
+    Handle admit(Segment &segment, unsigned char tag, const Key &key, const Value &value) {
+        segment.emplace_front(Entry{key, value, tag});
+        Handle handle = segment.frontNode();
+        index.insert(key, handle);
+        return handle;
+    }
+
+    Handle transfer(Segment &from, Handle handle, Segment &to, unsigned char tag) {
+        Entry &entry = entryOf(handle);
+        to.emplace_front(Entry{std::move(entry.key), std::move(entry.value), tag});
+        from.eraseNode(handle);
+        Handle moved = to.frontNode();
+        *index.find(entryOf(moved).key) = moved;
+        return moved;
+    }
+
+    // 从试用段晋升到保护段，保护段溢出时把其末尾条目降级回试用段头部。
+    // 返回此后持有该条目的句柄：保护段只容纳一个条目以下时，刚晋升的条目本身就会被降级
+    Handle promote(Segment &probation, Handle handle, Segment &protectedSegment, size_t protectedCapacity,
+                   unsigned char probationTag, unsigned char protectedTag) {
+        Handle promoted = transfer(probation, handle, protectedSegment, protectedTag);
+        if (protectedSegment.getSize() > protectedCapacity) {
+            const bool demotingPromoted = protectedSegment.backNode() == promoted;
+            Handle demoted = transfer(protectedSegment, protectedSegment.backNode(), probation, probationTag);
+            if (demotingPromoted) return demoted;
+        }
+        return promoted;
+    }
+
+    void evictBack(Segment &segment) {
+        Handle victim = segment.backNode();
+        index.erase(entryOf(victim).key);
+        segment.eraseNode(victim);
+    }
+};
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruPolicy : CachePolicyBase<Key, Value, Hash> {
+    using Base = CachePolicyBase<Key, Value, Hash>;
+
+public:
+    using typename Base::Handle;
+    using typename Base::Index;
+
+private:
+    typename Base::Segment recency;
+    size_t capacity;
+
+public:
+    LruPolicy(size_t cap, Index &idx, const Hash & = Hash()) : Base(idx), capacity(cap) {}
+
+    void recordAccess(const Key &) {}
+
+    Value &onHit(Handle handle) {
+        recency.moveToFront(handle);
+        return Base::entryOf(handle).value;
+    }
+
+    void insert(const Key &key, const Value &value) {
+        if (capacity == 0) return;
+        if (recency.getSize() == capacity) evict();
+        this->admit(recency, 0, key, value);
+    }
+
+    bool evict() {
+        if (recency.empty()) return false;
+        this->evictBack(recency);
+        return true;
+    }
+
+    void erase(Handle handle) { recency.eraseNode(handle); }
+    size_t size() const { return recency.getSize(); }
+    void clear() { recency.clear(); }
+};
+
+// 分段 LRU：新条目进入试用段，再次命中后晋升到保护段；保护段溢出时降级回试用段头部。
+// 保护段约占容量的 80%，容量非零时至少为 1
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class SlruPolicy : CachePolicyBase<Key, Value, Hash> {
+    using Base = CachePolicyBase<Key, Value, Hash>;
+
+public:
+    using typename Base::Handle;
+    using typename Base::Index;
+
+private:
+    enum : unsigned char { kProbation = 0, kProtected = 1 };
+
+    typename Base::Segment probation;
+    typename Base::Segment protected_;
+    size_t capacity;
+    size_t protectedCapacity;
+
+public:
+    SlruPolicy(size_t cap, Index &idx, const Hash & = Hash())
+        : Base(idx), capacity(cap), protectedCapacity(cap == 0 ? 0 : std::max<size_t>(1, cap * 4 / 5)) {}
+
+    void recordAccess(const Key &) {}
+
+    Value &onHit(Handle handle) {
+        if (Base::entryOf(handle).segment == kProtected) {
+            protected_.moveToFront(handle);
+            return Base::entryOf(handle).value;
+        }
+        return Base::entryOf(this->promote(probation, handle, protected_, protectedCapacity, kProbation, kProtected)).value;
+    }
+
+    void insert(const Key &key, const Value &value) {
+        if (capacity == 0) return;
+        if (size() == capacity) evict();
+        this->admit(probation, kProbation, key, value);
+    }
+
+    bool evict() {
+        if (!probation.empty()) {
+            this->evictBack(probation);
+        } else if (!protected_.empty()) {
+            this->evictBack(protected_);
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    void erase(Handle handle) {
+        if (Base::entryOf(handle).segment == kProtected) protected_.eraseNode(handle);
+        else probation.eraseNode(handle);
+    }
+
+    size_t size() const { return probation.getSize() + protected_.getSize(); }
+
+    void clear() {
+        probation.clear();
+        protected_.clear();
+    }
+};
+
+// Count-Min Sketch，4 位饱和计数器；累计增量达到采样上限后全部减半，让旧的热度逐渐衰减
+template <typename Key, typename Hash = std::hash<Key>>
+class FrequencySketch {
+    static constexpr unsigned kDepth = 4;
+    static constexpr std::uint8_t kMaxCount = 15;
+
+    std::vector<std::uint8_t> table;
+    size_t mask;
+    size_t additions = 0;
+    size_t sampleSize;
+    Hash hashFunction;
+
+    static std::uint64_t mix(std::uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    size_t slot(std::uint64_t hash, unsigned row) const {
+        return row * (mask + 1) + (mix(hash + row * 0x632be59bd9b4e019ULL) & mask);
+    }
+
+public:
+    explicit FrequencySketch(size_t capacity, const Hash &hashFunc = Hash()) : hashFunction(hashFunc) {
+        size_t width = 16;
+        while (width < capacity) width <<= 1;
+        table.assign(width * kDepth, 0);
+        mask = width - 1;
+        sampleSize = width * 10;
+    }
+
+    void increment(const Key &key) {
+        const std::uint64_t hash = hashFunction(key);
+        bool added = false;
+        for (unsigned row = 0; row < kDepth; ++row) {
+            std::uint8_t &counter = table[slot(hash, row)];
+            if (counter < kMaxCount) {
+                ++counter;
+                added = true;
+            }
+        }
+        if (added && ++additions == sampleSize) {
+            for (std::uint8_t &counter : table) counter >>= 1;
+            additions /= 2;
+        }
+    }
+
+    unsigned estimate(const Key &key) const {
+        const std::uint64_t hash = hashFunction(key);
+        unsigned result = kMaxCount;
+        for (unsigned row = 0; row < kDepth; ++row) {
+            result = std::min<unsigned>(result, table[slot(hash, row)]);
+        }
+        return result;
+    }
+
+    void clear() {
+        std::fill(table.begin(), table.end(), 0);
+        additions = 0;
+    }
+};
+
+// W-TinyLFU：新条目先进 1% 的窗口 LRU；被挤出窗口的候选者只有在频率高于主区淘汰者时才被接纳
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class WTinyLfuPolicy : CachePolicyBase<Key, Value, Hash> {
+    using Base = CachePolicyBase<Key, Value, Hash>;
+
+public:
+    using typename Base::Handle;
+    using typename Base::Index;
+
+private:
+    enum : unsigned char { kWindow = 0, kProbation = 1, kProtected = 2 };
+
+    typename Base::Segment window;
+    typename Base::Segment probation;
+    typename Base::Segment protected_;
+    size_t windowCapacity;
+    size_t mainCapacity;
+    size_t protectedCapacity;
+    FrequencySketch<Key, Hash> sketch;
+
+    typename Base::Segment &segmentOf(Handle handle) {
+        switch (Base::entryOf(handle).segment) {
+        case kWindow: return window;
+        case kProbation: return probation;
+        default: return protected_;
+        }
+    }
+
+    typename Base::Segment *mainVictimSegment() {
+        if (!probation.empty()) return &probation;
+        if (!protected_.empty()) return &protected_;
+        return nullptr;
+    }
+
+public:
+    WTinyLfuPolicy(size_t cap, Index &idx, const Hash &hashFunc = Hash())
+        : Base(idx),
+          windowCapacity(cap == 0 ? 0 : std::max<size_t>(1, cap / 100)),
+          mainCapacity(cap - windowCapacity),
+          protectedCapacity(mainCapacity == 0 ? 0 : std::max<size_t>(1, mainCapacity * 4 / 5)),
+          sketch(cap, hashFunc) {}
+
+    void recordAccess(const Key &key) { sketch.increment(key); }
+
+    Value &onHit(Handle handle) {
+        const unsigned char tag = Base::entryOf(handle).segment;
+        if (tag != kProbation) {
+            segmentOf(handle).moveToFront(handle);
+            return Base::entryOf(handle).value;
+        }
+        return Base::entryOf(this->promote(probation, handle, protected_, protectedCapacity, kProbation, kProtected)).value;
+    }
+
+    void insert(const Key &key, const Value &value) {
+        if (windowCapacity == 0) return;
+        this->admit(window, kWindow, key, value);
+        if (window.getSize() <= windowCapacity) return;
+
+        Handle candidate = window.backNode();
+        if (probation.getSize() + protected_.getSize() < mainCapacity) {
+            this->transfer(window, candidate, probation, kProbation);
+            return;
+        }
+        typename Base::Segment *victimSegment = mainVictimSegment();
+        if (!victimSegment) {
+            this->evictBack(window);
+            return;
+        }
+        const Key &victimKey = Base::entryOf(victimSegment->backNode()).key;
+        if (sketch.estimate(Base::entryOf(candidate).key) > sketch.estimate(victimKey)) {
+            this->evictBack(*victimSegment);
+            this->transfer(window, candidate, probation, kProbation);
+        } else {
+            this->evictBack(window);
+        }
+    }
+
+    bool evict() {
+        if (typename Base::Segment *segment = mainVictimSegment()) {
+            this->evictBack(*segment);
+        } else if (!window.empty()) {
+            this->evictBack(window);
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    void erase(Handle handle) { segmentOf(handle).eraseNode(handle); }
+
+    size_t size() const { return window.getSize() + probation.getSize() + protected_.getSize(); }
+
+    void clear() {
+        window.clear();
+        probation.clear();
+        protected_.clear();
+        sketch.clear();
+    }
+};
+
+template <typename Key, typename Value,
+          template <typename, typename, typename> class Policy = LruPolicy,
+          typename Hash = std::hash<Key>>
+class Cache {
+    using PolicyType = Policy<Key, Value, Hash>;
+    using Handle = typename PolicyType::Handle;
+
+    typename PolicyType::Index index;
+    PolicyType policy;
+    size_t capacity_;
+    size_t hits = 0;
+    size_t misses = 0;
+
+    // 按容量预留桶，避免稳定运行时触发 rehash
+    static size_t tableSizeFor(size_t capacity) { return std::max<size_t>(10, capacity * 4 / 3 + 1); }
+
+public:
+    explicit Cache(size_t capacity, const Hash &hashFunc = Hash())
+        : index(tableSizeFor(capacity), hashFunc), policy(capacity, index, hashFunc), capacity_(capacity) {}
+
+    Cache(const Cache &) = delete;
+    Cache &operator=(const Cache &) = delete;
+
+    // 返回的指针在下一次修改缓存前有效
+    Value *get(const Key &key) {
+        policy.recordAccess(key);
+        Handle *handle = index.find(key);
+        if (!handle) {
+            ++misses;
+            return nullptr;
+        }
+        ++hits;
+        return &policy.onHit(*handle);
+    }
+
+    void put(const Key &key, const Value &value) {
+        policy.recordAccess(key);
+        if (Handle *handle = index.find(key)) {
+            policy.onHit(*handle) = value;
+            return;
+        }
+        policy.insert(key, value);
+    }
+
+    bool erase(const Key &key) {
+        Handle *handle = index.find(key);
+        if (!handle) return false;
+        policy.erase(*handle);
+        index.erase(key);
+        return true;
+    }
+
+    bool evict() { return policy.evict(); }
+
+    void clear() {
+        policy.clear();
+        index.clear();
+        hits = misses = 0;
+    }
+
+    size_t size() const { return policy.size(); }
+    size_t capacity() const { return capacity_; }
+    size_t hitCount() const { return hits; }
+    size_t missCount() const { return misses; }
+};
+
+// 分片的线程安全缓存：按 key 的哈希选择分片，每个分片一把互斥锁，get 返回值的拷贝
+template <typename Key, typename Value,
+          template <typename, typename, typename> class Policy = LruPolicy,
+          typename Hash = std::hash<Key>>
+class ShardedCache {
+    struct Shard {
+        std::mutex mutex;
+        Cache<Key, Value, Policy, Hash> cache;
+        Shard(size_t capacity, const Hash &hashFunc) : cache(capacity, hashFunc) {}
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    Hash hashFunction;
+
+    Shard &shardFor(const Key &key) {
+        std::uint64_t h = hashFunction(key);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return *shards[h % shards.size()];
+    }
+
+public:
+    // 各分片容量之和恰好等于 capacity：每片 capacity / shardCount，余数分给前几片。
+    // 分片数多于容量时收缩到 capacity 片，避免出现容量为 0、永远不命中的分片
+    explicit ShardedCache(size_t capacity, size_t shardCount = 16, const Hash &hashFunc = Hash())
+        : hashFunction(hashFunc) {
+        if (shardCount == 0) throw std::invalid_argument("ShardedCache needs at least one shard");
+        shardCount = std::min(shardCount, std::max<size_t>(capacity, 1));
+        const size_t perShard = capacity / shardCount;
+        const size_t remainder = capacity % shardCount;
+        shards.reserve(shardCount);
+        for (size_t i = 0; i < shardCount; ++i) {
+            shards.push_back(std::make_unique<Shard>(perShard + (i < remainder ? 1 : 0), hashFunc));
+        }
+    }
+
+    std::optional<Value> get(const Key &key) {
+        Shard &shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (Value *value = shard.cache.get(key)) return *value;
+        return std::nullopt;
+    }
+
+    void put(const Key &key, const Value &value) {
+        Shard &shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.cache.put(key, value);
+    }
+
+    bool erase(const Key &key) {
+        Shard &shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.cache.erase(key);
+    }
+
+    size_t size() {
+        size_t total = 0;
+        for (auto &shard : shards) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            total += shard->cache.size();
+        }
+        return total;
+    }
+
+    size_t capacity() const {
+        size_t total = 0;
+        for (const auto &shard : shards) total += shard->cache.capacity();
+        return total;
+    }
+
+    size_t shardCount() const { return shards.size(); }
+
+    size_t hitCount() {
+        size_t total = 0;
+        for (auto &shard : shards) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            total += shard->cache.hitCount();
+        }
+        return total;
+    }
+
+    size_t missCount() {
+        size_t total = 0;
+        for (auto &shard : shards) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            total += shard->cache.missCount();
+        }
+        return total;
+    }
+};